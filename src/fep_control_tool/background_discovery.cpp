@@ -0,0 +1,290 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "background_discovery.h"
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+
+#include <a_util/strings.h>
+
+namespace
+{
+    std::vector<std::string> getParticipantNames(const fep3::System& system)
+    {
+        std::vector<std::string> names;
+        for (const auto& participant : system.getParticipants())
+        {
+            names.push_back(participant.getName());
+        }
+        return names;
+    }
+
+    constexpr size_t history_limit = 64u;
+
+    bool isEmpty(const background_discovery::SystemDelta& delta)
+    {
+        return delta._joined.empty() && delta._left.empty();
+    }
+
+    /// adds the participant with the priorities it had when it was removed, to be called with the operation lock held
+    void addParticipant(system_registry::SystemEntry& entry, const std::string& participant_name)
+    {
+        entry._system.add(participant_name);
+        const auto removed = entry._removed_priorities.find(participant_name);
+        if (removed == entry._removed_priorities.end())
+        {
+            return;
+        }
+        auto participant = entry._system.getParticipant(participant_name);
+        if (participant)
+        {
+            participant.setInitPriority(removed->second.first);
+            participant.setStartPriority(removed->second.second);
+        }
+        entry._removed_priorities.erase(removed);
+    }
+
+    /// removes the participant and keeps its priorities, to be called with the operation lock held
+    void removeParticipant(system_registry::SystemEntry& entry, const std::string& participant_name)
+    {
+        auto participant = entry._system.getParticipant(participant_name);
+        if (participant)
+        {
+            entry._removed_priorities[participant_name] =
+                std::make_pair(participant.getInitPriority(), participant.getStartPriority());
+        }
+        entry._system.remove(participant_name);
+        entry._proxies.invalidate(participant_name);
+        entry._missed_participants.erase(participant_name);
+    }
+
+    /// counts the misses of @p missing and removes those missed @p miss_limit times in a row, returns the removed ones
+    std::vector<std::string> removeMissedParticipants(system_registry::SystemEntry& entry,
+                                                      const std::vector<std::string>& missing,
+                                                      size_t miss_limit)
+    {
+        std::vector<std::string> removed;
+        for (const auto& participant_name : missing)
+        {
+            if (++entry._missed_participants[participant_name] >= miss_limit)
+            {
+                removeParticipant(entry, participant_name);
+                removed.push_back(participant_name);
+            }
+        }
+        return removed;
+    }
+}
+
+background_discovery::SystemDelta background_discovery::computeDelta(const std::string& system_name,
+                                                                     std::vector<std::string> known,
+                                                                     std::vector<std::string> discovered)
+{
+    std::sort(known.begin(), known.end());
+    std::sort(discovered.begin(), discovered.end());
+    SystemDelta delta;
+    delta._system_name = system_name;
+    std::set_difference(discovered.begin(), discovered.end(), known.begin(), known.end(),
+        std::back_inserter(delta._joined));
+    std::set_difference(known.begin(), known.end(), discovered.begin(), discovered.end(),
+        std::back_inserter(delta._left));
+    return delta;
+}
+
+std::vector<background_discovery::SystemDelta> background_discovery::merge(system_registry::SystemRegistry& registry,
+                                                                           NamedSystems&& discovered,
+                                                                           size_t miss_limit)
+{
+    std::vector<SystemDelta> deltas;
+    std::set<std::string> discovered_names;
+    for (auto& named_system : discovered)
+    {
+        const auto& system_name = named_system.first;
+        discovered_names.insert(system_name);
+        const auto discovered_participants = getParticipantNames(named_system.second);
+        auto inserted = registry.insert(system_name, std::move(named_system.second));
+        if (inserted.second)
+        {
+            inserted.first->_inserted_by_discovery = true;
+            deltas.push_back(computeDelta(system_name, {}, discovered_participants));
+            continue;
+        }
+        auto& entry = inserted.first;
+        std::unique_lock<std::mutex> operation_lock(entry->_operation_mutex, std::try_to_lock);
+        if (!operation_lock.owns_lock())
+        {
+            continue;
+        }
+        entry->_missed_discoveries = 0u;
+        auto delta = computeDelta(system_name, getParticipantNames(entry->_system), discovered_participants);
+        for (const auto& participant_name : discovered_participants)
+        {
+            entry->_missed_participants.erase(participant_name);
+        }
+        for (const auto& participant_name : delta._joined)
+        {
+            addParticipant(*entry, participant_name);
+        }
+        delta._left = removeMissedParticipants(*entry, delta._left, miss_limit);
+        deltas.push_back(std::move(delta));
+    }
+    for (const auto& entry : registry.getAll())
+    {
+        if (discovered_names.count(entry->_name) != 0u || !entry->_inserted_by_discovery)
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> operation_lock(entry->_operation_mutex, std::try_to_lock);
+        if (!operation_lock.owns_lock())
+        {
+            continue;
+        }
+        if (++entry->_missed_discoveries < miss_limit)
+        {
+            continue;
+        }
+        auto delta = computeDelta(entry->_name, getParticipantNames(entry->_system), {});
+        for (const auto& participant_name : delta._left)
+        {
+            removeParticipant(*entry, participant_name);
+        }
+        deltas.push_back(std::move(delta));
+    }
+    deltas.erase(std::remove_if(deltas.begin(), deltas.end(), isEmpty), deltas.end());
+    return deltas;
+}
+
+void background_discovery::printDelta(std::ostream& out, const SystemDelta& delta)
+{
+    out << "####### participants changed! #######" << std::endl;
+    out << "        system: " << delta._system_name << std::endl;
+    if (!delta._joined.empty())
+    {
+        out << "        joined: " << a_util::strings::join(delta._joined, ", ") << std::endl;
+    }
+    if (!delta._left.empty())
+    {
+        out << "        left: " << a_util::strings::join(delta._left, ", ") << std::endl;
+    }
+}
+
+background_discovery::BackgroundDiscovery::BackgroundDiscovery(system_registry::SystemRegistry& registry,
+                                                               DiscoverFunction discover,
+                                                               DeltaCallback on_delta)
+    : _registry(registry), _discover(std::move(discover)), _on_delta(std::move(on_delta))
+{
+}
+
+background_discovery::BackgroundDiscovery::~BackgroundDiscovery()
+{
+    stop();
+}
+
+bool background_discovery::BackgroundDiscovery::start(std::chrono::milliseconds interval)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_worker.joinable())
+    {
+        return false;
+    }
+    _stop = false;
+    _worker = std::thread(&BackgroundDiscovery::run, this, interval);
+    return true;
+}
+
+bool background_discovery::BackgroundDiscovery::stop()
+{
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_worker.joinable())
+        {
+            return false;
+        }
+        _stop = true;
+        worker.swap(_worker);
+    }
+    _stop_requested.notify_all();
+    worker.join();
+    return true;
+}
+
+bool background_discovery::BackgroundDiscovery::isRunning() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _worker.joinable();
+}
+
+bool background_discovery::BackgroundDiscovery::waitForDeltas(uint64_t after_generation,
+                                                              std::chrono::milliseconds timeout,
+                                                              std::vector<SystemDelta>& deltas,
+                                                              uint64_t& generation)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_deltas_available.wait_for(lock, timeout, [&]() { return _generation > after_generation; }))
+    {
+        return false;
+    }
+    deltas.clear();
+    for (const auto& refresh : _history)
+    {
+        if (refresh.first > after_generation)
+        {
+            deltas.insert(deltas.end(), refresh.second.begin(), refresh.second.end());
+        }
+    }
+    generation = _generation;
+    return true;
+}
+
+void background_discovery::BackgroundDiscovery::run(std::chrono::milliseconds interval)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop)
+    {
+        lock.unlock();
+        std::vector<SystemDelta> deltas;
+        try
+        {
+            deltas = merge(_registry, _discover());
+        }
+        catch (const std::exception&)
+        {
+            //a failed refresh is retried with the next one
+        }
+        if (!deltas.empty() && _on_delta)
+        {
+            _on_delta(deltas);
+        }
+        lock.lock();
+        if (!deltas.empty())
+        {
+            _history.emplace_back(++_generation, std::move(deltas));
+            if (_history.size() > history_limit)
+            {
+                _history.pop_front();
+            }
+            _deltas_available.notify_all();
+        }
+        _stop_requested.wait_for(lock, interval, [this]() { return _stop; });
+    }
+}
@@ -0,0 +1,116 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "system_registry.h"
+
+namespace background_discovery
+{
+    /// participants that joined or left one system since the last refresh
+    struct SystemDelta
+    {
+        std::string _system_name;
+        std::vector<std::string> _joined;
+        std::vector<std::string> _left;
+    };
+
+    typedef std::vector<std::pair<std::string, fep3::System>> NamedSystems;
+
+    /// participants in @p discovered but not in @p known joined, the other way round they left
+    SystemDelta computeDelta(const std::string& system_name,
+                             std::vector<std::string> known,
+                             std::vector<std::string> discovered);
+
+    /// consecutive refreshes a participant or system has to be missing before it is removed
+    constexpr size_t default_miss_limit = 3u;
+
+    /**
+     * Merges @p discovered into @p registry and returns the non empty deltas.
+     * Unknown systems are inserted, known ones get their participants added and removed in place,
+     * so a registered monitoring stays intact. A participant is removed only after missing in @p miss_limit
+     * merges in a row, a rejoining participant gets back the priorities it had when it was removed.
+     * Systems missing in @p discovered lose their participants the same way, but only if they were inserted
+     * by a merge, systems connected by other commands are never pruned.
+     * Systems busy with an operation are skipped and merged by the next refresh.
+     */
+    std::vector<SystemDelta> merge(system_registry::SystemRegistry& registry,
+                                   NamedSystems&& discovered,
+                                   size_t miss_limit = default_miss_limit);
+
+    void printDelta(std::ostream& out, const SystemDelta& delta);
+
+    /**
+     * Refreshes the registry periodically on a background thread.
+     * Deltas are passed to the callback first and then to the waiters.
+     */
+    class BackgroundDiscovery
+    {
+    public:
+        typedef std::function<NamedSystems()> DiscoverFunction;
+        typedef std::function<void(const std::vector<SystemDelta>&)> DeltaCallback;
+
+        BackgroundDiscovery(system_registry::SystemRegistry& registry, DiscoverFunction discover, DeltaCallback on_delta);
+        ~BackgroundDiscovery();
+
+        /// returns false if it is already running
+        bool start(std::chrono::milliseconds interval);
+        /// waits for a running refresh to finish, returns false if it was not running
+        bool stop();
+        bool isRunning() const;
+        /**
+         * Blocks until a refresh with deltas newer than @p after_generation happened and returns the deltas
+         * of all such refreshes still kept (the last 64) and the generation of the newest one in @p generation.
+         * Refreshes done before the call are included, so no change is missed between two calls.
+         * Returns false on timeout.
+         */
+        bool waitForDeltas(uint64_t after_generation,
+                           std::chrono::milliseconds timeout,
+                           std::vector<SystemDelta>& deltas,
+                           uint64_t& generation);
+
+    private:
+        void run(std::chrono::milliseconds interval);
+
+        system_registry::SystemRegistry& _registry;
+        DiscoverFunction _discover;
+        DeltaCallback _on_delta;
+        mutable std::mutex _mutex;
+        std::condition_variable _stop_requested;
+        std::condition_variable _deltas_available;
+        bool _stop = false;
+        uint64_t _generation = 0u;
+        /// deltas of the last refreshes with deltas, oldest first
+        std::deque<std::pair<uint64_t, std::vector<SystemDelta>>> _history;
+        std::thread _worker;
+    };
+}
@@ -0,0 +1,142 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+#include "cache_files.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+
+#ifdef WIN32
+#include <process.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <a_util/filesystem.h>
+
+namespace
+{
+    int getProcessId()
+    {
+#ifdef WIN32
+        return _getpid();
+#else
+        return static_cast<int>(::getpid());
+#endif
+    }
+
+    std::string getTemporaryDirectory()
+    {
+#ifdef WIN32
+        for (const char* variable : { "TEMP", "TMP" })
+        {
+            const char* directory = std::getenv(variable);
+            if (directory != nullptr)
+            {
+                return directory;
+            }
+        }
+        return ".";
+#else
+        const char* directory = std::getenv("TMPDIR");
+        return directory == nullptr ? "/tmp" : directory;
+#endif
+    }
+}
+
+bool cache_files::readFile(const std::string& file_name, std::string& content)
+{
+    std::ifstream file(file_name, std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !file.bad();
+}
+
+bool cache_files::writeFileAtomically(const std::string& file_name, const std::string& content)
+{
+    std::ostringstream temp_file_name;
+    temp_file_name << file_name << ".tmp" << getProcessId() << "_" << std::this_thread::get_id();
+    bool written = false;
+    {
+        std::ofstream file(temp_file_name.str(), std::ios::binary | std::ios::trunc);
+        written = file.write(content.data(), content.size()) && file.flush();
+    }
+    //the previous file stays untouched until the new one is complete
+#ifdef WIN32
+    const bool renamed = written
+        && MoveFileExA(temp_file_name.str().c_str(), file_name.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    const bool renamed = written && std::rename(temp_file_name.str().c_str(), file_name.c_str()) == 0;
+#endif
+    if (!renamed)
+    {
+        std::remove(temp_file_name.str().c_str());
+    }
+    return renamed;
+}
+
+void cache_files::createDirectories(const std::string& directory, std::initializer_list<const char*> sub_directories)
+{
+    const a_util::filesystem::Path path(directory);
+    for (const auto& parent : { path.getParent(), path })
+    {
+        if (!a_util::filesystem::exists(parent))
+        {
+            a_util::filesystem::createDirectory(parent);
+        }
+    }
+    for (const auto sub_directory : sub_directories)
+    {
+        if (!a_util::filesystem::exists(path + sub_directory))
+        {
+            a_util::filesystem::createDirectory(path + sub_directory);
+        }
+    }
+}
+
+std::string cache_files::getDefaultDirectory(const char* environment_variable)
+{
+    const char* directory = std::getenv(environment_variable);
+    return directory == nullptr ? "" : directory;
+}
+
+std::string cache_files::getUserDirectory(const std::string& name)
+{
+#ifdef WIN32
+    const char* home = std::getenv("LOCALAPPDATA");
+#else
+    const char* home = std::getenv("HOME");
+#endif
+    return home == nullptr ? "" : std::string(home) + "/.fep_control/" + name;
+}
+
+std::string cache_files::getTemporaryFileName(const std::string& name)
+{
+    std::ostringstream file_name;
+    file_name << getTemporaryDirectory() << "/" << name << "." << getProcessId() << "_" << std::this_thread::get_id();
+    return file_name.str();
+}
@@ -0,0 +1,47 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <initializer_list>
+#include <string>
+
+/// file helpers shared by the disk caches (definition_cache, property_cache) and temporary files of commands
+namespace cache_files
+{
+    bool readFile(const std::string& file_name, std::string& content);
+
+    /**
+     * Writes @p content to a temporary file named after the process and the thread and renames it to @p file_name,
+     * so several tools (and threads) can share a cache directory without reading half written files.
+     * An existing @p file_name is replaced only once the new content is complete.
+     */
+    bool writeFileAtomically(const std::string& file_name, const std::string& content);
+
+    /// creates the parent of @p directory, @p directory and its @p sub_directories if they do not exist
+    void createDirectories(const std::string& directory, std::initializer_list<const char*> sub_directories = {});
+
+    /// the value of @p environment_variable, empty (cache turned off) if it is not set
+    std::string getDefaultDirectory(const char* environment_variable);
+
+    /// "<home directory of the user>/.fep_control/<name>", empty if there is no home directory
+    std::string getUserDirectory(const std::string& name);
+
+    /// "<temporary directory of the system>/<name>.<process id>_<thread id>", unique for the calling thread
+    std::string getTemporaryFileName(const std::string& name);
+}
@@ -0,0 +1,201 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "configuration_watcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <limits.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include <a_util/filesystem.h>
+
+#ifndef __linux__
+#include "cache_files.h"
+#include "content_hash.h"
+#endif
+
+namespace
+{
+    //the stop flag is checked at least that often
+    const std::chrono::milliseconds poll_interval(100);
+
+#ifndef __linux__
+    //the modification time has a resolution of one second on some file systems, edits within it are seen by the content
+    bool getContentHash(const std::string& file_name, uint64_t& hash)
+    {
+        std::string content;
+        if (!cache_files::readFile(file_name, content))
+        {
+            return false;
+        }
+        hash = content_hash::hash(content);
+        return true;
+    }
+#endif
+}
+
+configuration_watcher::FileWatcher::FileWatcher(const std::string& file_name) : _file_name(file_name)
+{
+#ifdef __linux__
+    const a_util::filesystem::Path path(file_name);
+    _base_name = path.getLastElement().toString();
+    _inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (_inotify < 0)
+    {
+        throw std::runtime_error("cannot initialize inotify");
+    }
+    if (inotify_add_watch(_inotify, path.getParent().toString().c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0)
+    {
+        close(_inotify);
+        throw std::runtime_error("cannot watch the directory of \"" + file_name + "\"");
+    }
+#else
+    if (!getContentHash(_file_name, _hash))
+    {
+        throw std::runtime_error("cannot watch \"" + file_name + "\"");
+    }
+#endif
+}
+
+configuration_watcher::FileWatcher::~FileWatcher()
+{
+#ifdef __linux__
+    close(_inotify);
+#endif
+}
+
+bool configuration_watcher::FileWatcher::waitForModification(std::chrono::milliseconds timeout)
+{
+#ifdef __linux__
+    pollfd descriptor = { _inotify, POLLIN, 0 };
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;)
+    {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (poll(&descriptor, 1, static_cast<int>(std::max<int64_t>(remaining.count(), 0))) <= 0)
+        {
+            return false;
+        }
+        //events of other files in the directory are drained and ignored
+        alignas(inotify_event) char buffer[16u * (sizeof(inotify_event) + NAME_MAX + 1u)];
+        bool modified = false;
+        ssize_t size;
+        while ((size = read(_inotify, buffer, sizeof(buffer))) > 0)
+        {
+            for (char* position = buffer; position < buffer + size; )
+            {
+                const auto event = reinterpret_cast<const inotify_event*>(position);
+                modified = modified || (event->len > 0u && _base_name == event->name);
+                position += sizeof(inotify_event) + event->len;
+            }
+        }
+        if (modified)
+        {
+            return true;
+        }
+    }
+#else
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;)
+    {
+        uint64_t hash = 0u;
+        if (getContentHash(_file_name, hash) && hash != _hash)
+        {
+            _hash = hash;
+            return true;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= deadline)
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - now, poll_interval));
+    }
+#endif
+}
+
+std::map<std::string, std::vector<system_properties::Property>> configuration_watcher::diff(
+    const system_properties::PropertyFile& before,
+    const system_properties::PropertyFile& after,
+    const std::vector<std::string>& participant_names)
+{
+    const auto properties_before = system_properties::resolve(before, participant_names);
+    std::map<std::string, std::vector<system_properties::Property>> changed;
+    for (const auto& participant : system_properties::resolve(after, participant_names))
+    {
+        const auto& previous = properties_before.at(participant.first);
+        for (const auto& property : participant.second)
+        {
+            if (std::find(previous.begin(), previous.end(), property) == previous.end())
+            {
+                changed[participant.first].push_back(property);
+            }
+        }
+    }
+    return changed;
+}
+
+configuration_watcher::ConfigurationWatcher::ConfigurationWatcher(const std::string& file_name,
+                                                                  std::chrono::milliseconds debounce,
+                                                                  ChangeCallback on_change)
+    : _file_watcher(file_name), _debounce(debounce), _on_change(std::move(on_change))
+{
+    _worker = std::thread(&ConfigurationWatcher::run, this);
+}
+
+configuration_watcher::ConfigurationWatcher::~ConfigurationWatcher()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _worker.join();
+}
+
+bool configuration_watcher::ConfigurationWatcher::isStopped()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _stop;
+}
+
+void configuration_watcher::ConfigurationWatcher::run()
+{
+    while (!isStopped())
+    {
+        if (!_file_watcher.waitForModification(poll_interval))
+        {
+            continue;
+        }
+        //editors write in several steps, the burst is over once the file stays quiet for the debounce time
+        while (!isStopped() && _file_watcher.waitForModification(_debounce))
+        {
+        }
+        if (!isStopped())
+        {
+            _on_change();
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "system_properties.h"
+
+namespace configuration_watcher
+{
+    /**
+     * Notices modifications of one file. Uses inotify on the directory of the file on Linux,
+     * so editors replacing the file are noticed as well, and polls the content hash elsewhere.
+     */
+    class FileWatcher
+    {
+    public:
+        /// @p file_name has to be absolute, throws std::runtime_error if the file cannot be watched
+        explicit FileWatcher(const std::string& file_name);
+        ~FileWatcher();
+        FileWatcher(const FileWatcher&) = delete;
+        FileWatcher& operator=(const FileWatcher&) = delete;
+
+        /// returns true as soon as the file was modified, false if it was not within @p timeout
+        bool waitForModification(std::chrono::milliseconds timeout);
+
+    private:
+        std::string _file_name;
+#ifdef __linux__
+        std::string _base_name;
+        int _inotify = -1;
+#else
+        uint64_t _hash = 0u;
+#endif
+    };
+
+    /**
+     * Returns the properties of @p after which are new or differ from @p before, per participant
+     * of @p participant_names. Properties which were removed from the file are not reset.
+     */
+    std::map<std::string, std::vector<system_properties::Property>> diff(const system_properties::PropertyFile& before,
+                                                                         const system_properties::PropertyFile& after,
+                                                                         const std::vector<std::string>& participant_names);
+
+    /**
+     * Watches a file on a background thread and calls the callback once per burst of modifications,
+     * after no further modification followed within the debounce time.
+     */
+    class ConfigurationWatcher
+    {
+    public:
+        typedef std::function<void()> ChangeCallback;
+
+        /// throws std::runtime_error if the file cannot be watched
+        ConfigurationWatcher(const std::string& file_name, std::chrono::milliseconds debounce, ChangeCallback on_change);
+        /// stops the thread, waits for a running callback
+        ~ConfigurationWatcher();
+
+    private:
+        void run();
+        bool isStopped();
+
+        FileWatcher _file_watcher;
+        const std::chrono::milliseconds _debounce;
+        ChangeCallback _on_change;
+        std::mutex _mutex;
+        bool _stop = false;
+        std::thread _worker;
+    };
+}
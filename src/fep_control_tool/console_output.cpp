@@ -0,0 +1,160 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+#include "console_output.h"
+#include "linenoise_wrapper.h"
+
+#include <iostream>
+#include <mutex>
+#include <streambuf>
+
+namespace
+{
+    //recursive, completions run while linenoise holds it and may print
+    std::recursive_mutex console_mutex;
+    std::streambuf* terminal = nullptr;
+    std::string current_prompt;
+    thread_local std::string* captured_text = nullptr;
+
+    void lockConsole()
+    {
+        console_mutex.lock();
+    }
+
+    void unlockConsole()
+    {
+        console_mutex.unlock();
+    }
+
+    /// linenoise turns off the output processing while it edits, so the lines have to end with "\r\n"
+    void writeLines(const std::string& text)
+    {
+        size_t begin = 0u;
+        for (auto end = text.find('\n'); end != std::string::npos; end = text.find('\n', begin))
+        {
+            terminal->sputn(text.data() + begin, static_cast<std::streamsize>(end - begin));
+            terminal->sputn("\r\n", 2);
+            begin = end + 1u;
+        }
+        terminal->sputn(text.data() + begin, static_cast<std::streamsize>(text.size() - begin));
+    }
+
+    /// the buffer of std::cout, it serializes writes to the terminal and diverts captured threads
+    class ConsoleBuffer : public std::streambuf
+    {
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                return traits_type::not_eof(c);
+            }
+            const char character = traits_type::to_char_type(c);
+            return xsputn(&character, 1) == 1 ? c : traits_type::eof();
+        }
+
+        std::streamsize xsputn(const char* text, std::streamsize count) override
+        {
+            if (captured_text)
+            {
+                captured_text->append(text, static_cast<size_t>(count));
+                return count;
+            }
+            std::lock_guard<std::recursive_mutex> lock(console_mutex);
+            return terminal->sputn(text, count);
+        }
+
+        int sync() override
+        {
+            if (captured_text)
+            {
+                return 0;
+            }
+            std::lock_guard<std::recursive_mutex> lock(console_mutex);
+            return terminal->pubsync();
+        }
+    };
+}
+
+void console_output::install()
+{
+    if (terminal)
+    {
+        return;
+    }
+    terminal = std::cout.rdbuf();
+    //never destroyed, std::cout is flushed after the static objects are gone
+    std::cout.rdbuf(new ConsoleBuffer());
+    line_noise::setEditLock(lockConsole, unlockConsole);
+}
+
+void console_output::setPrompt(const std::string& prompt)
+{
+    std::lock_guard<std::recursive_mutex> lock(console_mutex);
+    current_prompt = prompt;
+}
+
+void console_output::print(const std::string& text)
+{
+    if (!terminal)
+    {
+        std::cout << text << std::flush;
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> lock(console_mutex);
+    if (current_prompt.empty())
+    {
+        terminal->sputn(text.data(), static_cast<std::streamsize>(text.size()));
+        terminal->pubsync();
+        return;
+    }
+    //linenoise releases the lock only while it waits for a key, so the edited line does not change meanwhile
+    const bool editing = line_noise::isEditing();
+    //clear the edited line, or start below the prompt if the input is not a terminal
+    terminal->sputn(editing ? "\r\x1b[K" : "\r\n", editing ? 4 : 2);
+    writeLines(text);
+    if (editing)
+    {
+        terminal->pubsync();
+        line_noise::refreshLine();
+    }
+    else
+    {
+        terminal->sputn(current_prompt.data(), static_cast<std::streamsize>(current_prompt.size()));
+        terminal->pubsync();
+    }
+}
+
+console_output::Capture::Capture() : _enclosing(captured_text)
+{
+    captured_text = &_text;
+}
+
+console_output::Capture::~Capture()
+{
+    captured_text = _enclosing;
+    if (_enclosing)
+    {
+        _enclosing->append(_text);
+    }
+    else if (!_text.empty())
+    {
+        print(_text);
+    }
+}
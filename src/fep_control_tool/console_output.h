@@ -0,0 +1,54 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <string>
+
+namespace console_output
+{
+    /**
+     * Routes std::cout through the console, so output of background threads (jobs, discovery,
+     * watchers, monitor events) does not tear the prompt the user types at.
+     * Must be called once before other threads are started.
+     */
+    void install();
+
+    /// sets the prompt that is shown while waiting for input, empty while a command runs
+    void setPrompt(const std::string& prompt);
+
+    /// prints @p text in one piece above the prompt and the line typed so far, if the prompt is shown
+    void print(const std::string& text);
+
+    /**
+     * Collects everything the current thread writes to std::cout while it exists
+     * and prints it with print() when it is destroyed (or hands it to the enclosing capture).
+     */
+    class Capture
+    {
+    public:
+        Capture();
+        ~Capture();
+        Capture(const Capture&) = delete;
+        Capture& operator=(const Capture&) = delete;
+
+    private:
+        std::string _text;
+        std::string* _enclosing;
+    };
+}
@@ -0,0 +1,58 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "content_hash.h"
+
+void content_hash::Hasher::update(const char* data, size_t size)
+{
+    for (size_t index = 0u; index < size; ++index)
+    {
+        _hash ^= static_cast<unsigned char>(data[index]);
+        _hash *= 1099511628211ull;
+    }
+}
+
+void content_hash::Hasher::update(const std::string& data)
+{
+    update(data.data(), data.size());
+}
+
+uint64_t content_hash::Hasher::get() const
+{
+    return _hash;
+}
+
+uint64_t content_hash::hash(const std::string& data)
+{
+    Hasher hasher;
+    hasher.update(data);
+    return hasher.get();
+}
+
+std::string content_hash::toHex(uint64_t hash)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex(16u, '0');
+    for (size_t index = 16u; index-- > 0u; hash >>= 4u)
+    {
+        hex[index] = digits[hash & 0xfu];
+    }
+    return hex;
+}
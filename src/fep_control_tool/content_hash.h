@@ -0,0 +1,42 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace content_hash
+{
+    /// 64 bit FNV-1a, fed incrementally
+    class Hasher
+    {
+    public:
+        void update(const char* data, size_t size);
+        void update(const std::string& data);
+        uint64_t get() const;
+
+    private:
+        uint64_t _hash = 14695981039346656037ull;
+    };
+
+    uint64_t hash(const std::string& data);
+    /// 16 lower case hex digits
+    std::string toHex(uint64_t hash);
+}
@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <cctype>
 
+#include <a_util/filesystem.h>
+
 static std::string quoteFilenameIfNecessary(const std::string& file_name)
 {
     assert(!file_name.empty());
@@ -13,3 +15,77 @@ static std::string quoteFilenameIfNecessary(const std::string& file_name)
     }
     return "\"" + file_name + "\"";
 }
+
+inline std::string escapeJsonString(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size() + 2u);
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\r': escaped += "\\r"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20u)
+                {
+                    static const char hex_digits[] = "0123456789abcdef";
+                    escaped += "\\u00";
+                    escaped += hex_digits[(c >> 4) & 0xF];
+                    escaped += hex_digits[c & 0xF];
+                }
+                else
+                {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+inline bool matchesWildcard(const std::string& pattern, const std::string& value)
+{
+    // iterative glob match for '*' and '?' with backtracking to the last '*'
+    size_t p = 0u, v = 0u, star = std::string::npos, star_match = 0u;
+    while (v < value.size())
+    {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == value[v]))
+        {
+            ++p;
+            ++v;
+        }
+        else if (p < pattern.size() && pattern[p] == '*')
+        {
+            star = p++;
+            star_match = v;
+        }
+        else if (star != std::string::npos)
+        {
+            p = star + 1u;
+            v = ++star_match;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*')
+    {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+/// the tool's working directory can change, files kept for later use are resolved once
+inline std::string getAbsolutePath(const std::string& file_name)
+{
+    a_util::filesystem::Path path(file_name);
+    if (!path.isAbsolute())
+    {
+        path = a_util::filesystem::getWorkingDirectory() + path;
+    }
+    return path.makeCanonical().toString();
+}
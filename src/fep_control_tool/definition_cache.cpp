@@ -0,0 +1,143 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "definition_cache.h"
+
+#include <cctype>
+
+#include <a_util/filesystem.h>
+
+#include "cache_files.h"
+#include "content_hash.h"
+
+namespace
+{
+    /// IIDs are used as file names, everything but [A-Za-z0-9._-] is escaped as %XX
+    std::string toFileName(const std::string& iid)
+    {
+        static const char digits[] = "0123456789ABCDEF";
+        std::string file_name;
+        for (const char character : iid)
+        {
+            const auto value = static_cast<unsigned char>(character);
+            if (std::isalnum(value) || character == '.' || character == '_' || character == '-')
+            {
+                file_name += character;
+            }
+            else
+            {
+                file_name += '%';
+                file_name += digits[value >> 4u];
+                file_name += digits[value & 0xfu];
+            }
+        }
+        return file_name;
+    }
+}
+
+definition_cache::DefinitionCache::DefinitionCache(const std::string& directory)
+    : _directory(directory), _hits(0u), _misses(0u)
+{
+}
+
+void definition_cache::DefinitionCache::setDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directory = directory;
+    _index.clear();
+}
+
+std::string definition_cache::DefinitionCache::getDirectory() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _directory;
+}
+
+std::string definition_cache::DefinitionCache::get(const std::string& iid, const FetchFunction& fetch)
+{
+    const auto directory = getDirectory();
+    std::string definition;
+    if (!directory.empty() && load(directory, iid, definition))
+    {
+        ++_hits;
+        return definition;
+    }
+    ++_misses;
+    definition = fetch();
+    if (!directory.empty())
+    {
+        store(directory, iid, definition);
+    }
+    return definition;
+}
+
+uint64_t definition_cache::DefinitionCache::getHits() const
+{
+    return _hits;
+}
+
+uint64_t definition_cache::DefinitionCache::getMisses() const
+{
+    return _misses;
+}
+
+bool definition_cache::DefinitionCache::load(const std::string& directory, const std::string& iid, std::string& definition)
+{
+    std::string hash;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _index.find(iid);
+        if (it != _index.end())
+        {
+            hash = it->second;
+        }
+    }
+    if (hash.empty() && !cache_files::readFile(directory + "/index/" + toFileName(iid), hash))
+    {
+        return false;
+    }
+    //a damaged or foreign object is treated like a missing one
+    if (!cache_files::readFile(directory + "/objects/" + hash, definition)
+        || content_hash::toHex(content_hash::hash(definition)) != hash)
+    {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _index[iid] = hash;
+    return true;
+}
+
+void definition_cache::DefinitionCache::store(const std::string& directory, const std::string& iid, const std::string& definition)
+{
+    const auto hash = content_hash::toHex(content_hash::hash(definition));
+    cache_files::createDirectories(directory, { "index", "objects" });
+    const auto object_file_name = directory + "/objects/" + hash;
+    //the object is written first, so an index entry always points to a complete object
+    if (!a_util::filesystem::exists(a_util::filesystem::Path(object_file_name))
+        && !cache_files::writeFileAtomically(object_file_name, definition))
+    {
+        return;
+    }
+    if (cache_files::writeFileAtomically(directory + "/index/" + toFileName(iid), hash))
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _index[iid] = hash;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace definition_cache
+{
+    /**
+     * Content addressed disk cache of RPC interface definitions.
+     * The directory holds "objects/<hash>" with the definitions and "index/<iid>" with the hash
+     * of the definition of each IID. The version of an interface is part of its IID, so a definition
+     * is fetched once per interface version and shared by all participants implementing it.
+     * Files are written with cache_files::writeFileAtomically, so several tools can share a directory.
+     * All methods are thread safe.
+     */
+    class DefinitionCache
+    {
+    public:
+        typedef std::function<std::string()> FetchFunction;
+
+        explicit DefinitionCache(const std::string& directory);
+
+        /// an empty directory disables the cache
+        void setDirectory(const std::string& directory);
+        std::string getDirectory() const;
+
+        /// returns the cached definition of @p iid, calls @p fetch and stores its result if there is none
+        std::string get(const std::string& iid, const FetchFunction& fetch);
+
+        uint64_t getHits() const;
+        uint64_t getMisses() const;
+
+    private:
+        bool load(const std::string& directory, const std::string& iid, std::string& definition);
+        void store(const std::string& directory, const std::string& iid, const std::string& definition);
+
+        mutable std::mutex _mutex;
+        std::string _directory;
+        /// hashes of the definitions known in this session, saves reading the index files
+        std::map<std::string, std::string> _index;
+        std::atomic<uint64_t> _hits;
+        std::atomic<uint64_t> _misses;
+    };
+}
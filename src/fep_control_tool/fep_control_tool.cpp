@@ -17,16 +17,43 @@
  */
 
 #include <stdlib.h>
+#include <atomic>
 #include <iostream>
 #include <cctype>
+#include <cerrno>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <thread>
 
 #include <a_util/filesystem.h>
 
 #include <fep_system/fep_system.h>
 #include <fep_controller/fep_controller.h>
 #include "linenoise_wrapper.h"
+#include "console_output.h"
 #include "control_tool_common_helper.h"
+#include "transition_statistics.h"
+#include "process_memory.h"
+#include "worker_pool.h"
+#include "job_control.h"
+#include "system_registry.h"
+#include "background_discovery.h"
+#include "system_snapshot.h"
+#include "definition_cache.h"
+#include "rpc_call.h"
+#include "rpc_bench.h"
+#include "property_cache.h"
+#include "cache_files.h"
+#include "configuration_watcher.h"
+#include "timing_monitor.h"
+#include "timing_sweep.h"
+#include "timing_preflight.h"
+#include "system_state_table.h"
 
 static void skipWhitespace(const char*& p, const char* pAdditionalWhitechars = nullptr)
 {
@@ -144,32 +171,65 @@ namespace
     typedef std::function<bool(TokenIterator first, TokenIterator last)> ActionFunction;
     typedef std::function<std::vector<std::string>(const std::string& input)> ArgumentCompletionFunction;
 
-    std::map<std::string, fep3::System> connected_or_discovered_systems;
-    bool auto_discovery_of_systems = false;
-    std::string last_system_name_used = "";
+    system_registry::SystemRegistry connected_or_discovered_systems;
+    std::atomic<bool> auto_discovery_of_systems(false);
     const std::string empty_system_name = "-";
+    transition_statistics::TransitionStatistics transition_stats;
+    //the disk caches are off unless their directory is given by the environment or the commands below
+    definition_cache::DefinitionCache interface_definitions(cache_files::getDefaultDirectory("FEP_CONTROL_DEFINITION_CACHE"));
+    property_cache::PropertyCache compiled_properties(cache_files::getDefaultDirectory("FEP_CONTROL_PROPERTY_CACHE"));
+
+    /// one watched properties file per system
+    std::mutex configuration_watchers_mutex;
+    std::map<std::string, std::unique_ptr<configuration_watcher::ConfigurationWatcher>> configuration_watchers;
+
+    /// stops watching the properties file of @p system_name, returns false if none was watched
+    static bool stopConfigurationWatcher(const std::string& system_name)
+    {
+        std::unique_ptr<configuration_watcher::ConfigurationWatcher> watcher;
+        {
+            std::lock_guard<std::mutex> lock(configuration_watchers_mutex);
+            auto it = configuration_watchers.find(system_name);
+            if (it == configuration_watchers.end())
+            {
+                return false;
+            }
+            watcher = std::move(it->second);
+            configuration_watchers.erase(it);
+        }
+        //the watcher is stopped outside of the lock, it may wait for a running update
+        watcher.reset();
+        return true;
+    }
+
+    /// the watcher of a replaced system would keep pushing to the old handle, so it is stopped
+    static void insertOrAssignSystem(const std::string& name, fep3::System&& system)
+    {
+        connected_or_discovered_systems.insertOrAssign(name, std::move(system));
+        stopConfigurationWatcher(name);
+    }
 
     static void discoverSystemByName(const std::string& name)
     {
         auto system_name = name;
         //this updates for completion
-        last_system_name_used = system_name;
+        connected_or_discovered_systems.setLastUsedName(system_name);
         if (system_name == empty_system_name)
         {
             system_name = "";
         }
         auto system = fep3::discoverSystem(system_name);
-        connected_or_discovered_systems[system.getSystemName()] = std::move(system);
+        insertOrAssignSystem(system.getSystemName(), std::move(system));
     }
 
-    decltype(connected_or_discovered_systems)::iterator getConnectedOrDiscoveredSystem(const std::string& name, 
+    system_registry::SystemHandle getConnectedOrDiscoveredSystem(const std::string& name,
         bool auto_discovery)
     {
-        auto it = connected_or_discovered_systems.find(name);
-        if (it != connected_or_discovered_systems.end())
+        auto entry = connected_or_discovered_systems.find(name);
+        if (entry)
         {
-            last_system_name_used = name;
-            return it;
+            connected_or_discovered_systems.setLastUsedName(name);
+            return entry;
         }
         else
         {
@@ -180,7 +240,7 @@ namespace
             }
         }
         std::cout << "system \"" << name << "\" is not connected" << std::endl;
-        return connected_or_discovered_systems.end();
+        return nullptr;
     }
 
     struct ArgumentHandler
@@ -218,11 +278,11 @@ namespace
     std::vector<std::string> connectedSystemsCompletion(const std::string& word_prefix)
     {
         std::vector<std::string> completions;
-        for (const auto& system : connected_or_discovered_systems)
+        for (const auto& system_name : connected_or_discovered_systems.getNames())
         {
-            if (system.first.compare(0u, word_prefix.size(), word_prefix) == 0)
+            if (system_name.compare(0u, word_prefix.size(), word_prefix) == 0)
             {
-                completions.push_back(system.first);
+                completions.push_back(system_name);
             }
         }
         return completions;
@@ -231,10 +291,16 @@ namespace
     std::vector<std::string> connectedParticipantsCompletion(const std::string& word_prefix)
     {
         std::vector<std::string> completions;
-        const auto& found_system = connected_or_discovered_systems.find(last_system_name_used);
-        if (found_system != connected_or_discovered_systems.cend())
+        const auto found_system = connected_or_discovered_systems.find(connected_or_discovered_systems.getLastUsedName());
+        //no completion while a command is working on the system
+        std::unique_lock<std::mutex> operation_lock;
+        if (found_system)
+        {
+            operation_lock = std::unique_lock<std::mutex>(found_system->_operation_mutex, std::try_to_lock);
+        }
+        if (operation_lock.owns_lock())
         {
-            auto parts = found_system->second.getParticipants();
+            auto parts = found_system->_system.getParticipants();
             for (const auto& part : parts)
             {
                 if (part.getName().compare(0u, word_prefix.size(), word_prefix) == 0)
@@ -248,42 +314,43 @@ namespace
 
     fep3::SystemAggregatedState getStateFromString(const std::string& state_string)
     {
-        if (state_string == "shutdowned")
-        {
-            return fep3::SystemAggregatedState::unreachable;
-        }
-        else if (state_string == "unloaded")
-        {
-            return fep3::SystemAggregatedState::unloaded;
-        }
-        else if (state_string == "loaded")
-        {
-            return fep3::SystemAggregatedState::loaded;
-        }
-        else if (state_string == "initialized")
-        {
-            return fep3::SystemAggregatedState::initialized;
-        }
-        else if (state_string == "paused")
+        const auto entry = system_state_table::findByInputName(state_string);
+        return entry ? entry->_state : fep3::SystemAggregatedState::undefined;
+    }
+
+    static bool isSettableState(const std::string& state_string)
+    {
+        if (system_state_table::findByInputName(state_string))
         {
-            return fep3::SystemAggregatedState::paused;
+            return true;
         }
-        else if (state_string == "running")
+        std::cout << "invalid state \"" << state_string << "\", use shutdowned, unloaded, loaded, initialized, paused or running" << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> configurationModeCompletion(const std::string& word_prefix)
+    {
+        std::vector<std::string> completions;
+        for (const auto& mode : { "full", "delta" })
         {
-            return fep3::SystemAggregatedState::running;
+            if (std::string(mode).compare(0u, word_prefix.size(), word_prefix) == 0)
+            {
+                completions.push_back(mode);
+            }
         }
-        return fep3::SystemAggregatedState::undefined;
+        return completions;
     }
 
     std::vector<std::string> possibleSystemsStateCompletion(const std::string& word_prefix)
     {
         std::vector<std::string> completions;
-        std::vector<std::string> possible_states = { "shutdowned", "unloaded", "loaded", "initialized", "paused", "running" };
-        for (const auto& state_val : possible_states)
+        for (const auto& state : system_state_table::states)
         {
-            if (state_val.compare(0u, word_prefix.size(), word_prefix) == 0)
+            const auto& name = state._input_name;
+            if (name._size != 0u && word_prefix.size() <= name._size
+                && word_prefix.compare(0u, word_prefix.size(), name._data, word_prefix.size()) == 0)
             {
-                completions.push_back(state_val);
+                completions.emplace_back(name._data, name._size);
             }
         }
         return completions;
@@ -295,6 +362,10 @@ namespace
         ActionFunction _action;
         std::vector<ArgumentHandler> _arguments;
         size_t _last_optional_parameters;
+        /// commands working on the tool itself (help, jobs, ...) cannot be run in background
+        bool _allowed_in_background = true;
+        /// the last argument can be repeated any number of times
+        bool _variadic = false;
     };
 
     static std::string resolveFilesystemErrorCode(a_util::filesystem::Error error_code)
@@ -312,22 +383,6 @@ namespace
         return "UNKNOWN_ERROR";
     }
 
-    static std::string resolveSystemState(fep3::System::AggregatedState st)
-    {
-        switch (st)
-        {
-            case fep3::System::AggregatedState::undefined: return "undefined";
-            case fep3::System::AggregatedState::unreachable: return "unreachable";
-            case fep3::System::AggregatedState::unloaded: return "unloaded";
-            case fep3::System::AggregatedState::loaded: return "loaded";
-            case fep3::System::AggregatedState::initialized: return "initialized";
-            case fep3::System::AggregatedState::paused: return "paused";
-            case fep3::System::AggregatedState::running: return "running";
-            default: break;
-        }
-        return "NOT RESOLVABLE";
-    }
-
     static void dumpSystemParticipants(const fep3::System& system)
     {
         auto system_name = system.getSystemName();
@@ -358,20 +413,27 @@ namespace
     public:
         void onStateChanged(const std::string& participant, fep3::rpc::ParticipantState state) override
         {
+            console_output::Capture capture;
             std::cout << std::endl;
             std::cout << "####### state changed! #######" << std::endl;
             std::cout << "        participant: " << participant << std::endl;
-            std::cout << "        state: " << state << std::endl;
+            std::cout << "        state: " << system_state_table::getName(state) << std::endl;
         }
         void onNameChanged(const std::string& new_name, const std::string& old_name) override
         {
+            console_output::Capture capture;
             std::cout << std::endl;
             std::cout << "####### name changed! #######" << std::endl;
             std::cout << "        old name: " << old_name << std::endl;
             std::cout << "        new name: " << new_name << std::endl;
+            //the monitor does not know the system, so the old name is dropped everywhere
+            for (const auto& entry : connected_or_discovered_systems.getAll())
+            {
+                entry->_proxies.invalidate(old_name);
+            }
         }
 
-        std::string sevToString(fep3::logging::Severity severity_level)
+        const char* sevToString(fep3::logging::Severity severity_level)
         {
             if (fep3::logging::Severity::debug == severity_level)
             {
@@ -403,13 +465,44 @@ namespace
             const std::string& logger_name, //depends on the Category ... 
             const std::string& message) override
         {
-            std::cout << "    LOG " << sevToString(severity_level) << " " << logger_name 
-                << "@" << participant_name  << " :" << message << std::endl << "fep> ";
+            console_output::Capture capture;
+            std::cout << "    LOG " << sevToString(severity_level) << " " << logger_name
+                << "@" << participant_name << " :" << message << std::endl;
         }
     };
 
     Monitor monitor;
 
+    static background_discovery::NamedSystems discoverNamedSystems()
+    {
+        background_discovery::NamedSystems named_systems;
+        for (auto& system : fep3::discoverAllSystems())
+        {
+            auto system_name = system.getSystemName();
+            if (system_name.empty())
+            {
+                //special system name -
+                system_name = empty_system_name;
+            }
+            named_systems.emplace_back(system_name, std::move(system));
+        }
+        return named_systems;
+    }
+
+    background_discovery::BackgroundDiscovery system_discoverer(connected_or_discovered_systems,
+        discoverNamedSystems,
+        [](const std::vector<background_discovery::SystemDelta>& deltas)
+        {
+            console_output::Capture capture;
+            for (const auto& delta : deltas)
+            {
+                background_discovery::printDelta(std::cout, delta);
+            }
+        });
+
+    /// generation of the newest deltas printed by waitForParticipantChanges
+    std::atomic<uint64_t> seen_discovery_generation(0u);
+
     static bool discoverAllSystems(TokenIterator, TokenIterator)
     {
         auto systems = fep3::discoverAllSystems();
@@ -422,9 +515,9 @@ namespace
                 //special system name -
                 system_name = empty_system_name;
             }
-            connected_or_discovered_systems[system_name] = std::move(system);
+            insertOrAssignSystem(system_name, std::move(system));
             //this updates for completion
-            last_system_name_used = system_name;
+            connected_or_discovered_systems.setLastUsedName(system_name);
         }
         return true;
     }
@@ -433,17 +526,41 @@ namespace
     {
         auto system_name = *first;
         //this updates for completion
-        last_system_name_used = system_name;
+        connected_or_discovered_systems.setLastUsedName(system_name);
         if (system_name == empty_system_name)
         {
             system_name = "";
         }
         auto system = fep3::discoverSystem(system_name);
         dumpSystemParticipants(system);
-        connected_or_discovered_systems[system.getSystemName()] = std::move(system);
+        insertOrAssignSystem(system.getSystemName(), std::move(system));
         return true;
     }
 
+    static bool discoverSystems(TokenIterator first, TokenIterator last)
+    {
+        //one discovery window for all names instead of one per name
+        std::vector<std::string> missing_names(first, last);
+        for (auto& named_system : discoverNamedSystems())
+        {
+            auto it = std::remove(missing_names.begin(), missing_names.end(), named_system.first);
+            if (it == missing_names.end())
+            {
+                continue;
+            }
+            missing_names.erase(it, missing_names.end());
+            dumpSystemParticipants(named_system.second);
+            insertOrAssignSystem(named_system.first, std::move(named_system.second));
+            //this updates for completion
+            connected_or_discovered_systems.setLastUsedName(named_system.first);
+        }
+        for (const auto& system_name : missing_names)
+        {
+            std::cout << "system \"" << system_name << "\" was not found" << std::endl;
+        }
+        return missing_names.empty();
+    }
+
     static bool setCurrentWorkingDirectory(TokenIterator first, TokenIterator)
     {
         auto path = a_util::filesystem::Path(*first);
@@ -471,9 +588,9 @@ namespace
             fep3::System new_system = fep3::controller::connectSystem(fep_sdk_system_file);
             std::string new_system_name = new_system.getSystemName();
             //this updates for completion
-            last_system_name_used = new_system_name;
+            connected_or_discovered_systems.setLastUsedName(new_system_name);
             dumpSystemParticipants(new_system);
-            auto success = connected_or_discovered_systems.emplace(new_system_name, std::move(new_system));
+            auto success = connected_or_discovered_systems.insert(new_system_name, std::move(new_system));
             
             if (!success.second)
             {
@@ -491,27 +608,431 @@ namespace
     }
     static bool help(TokenIterator first, TokenIterator last);
 
-    static bool changeStateMethod(
-        TokenIterator first,
-        std::function<void(fep3::System& system)> call,
+    typedef fep3::RPCComponent<fep3::rpc::IRPCParticipantStateMachine> StateMachineProxy;
+    typedef fep3::rpc::ParticipantState ParticipantState;
+
+    struct StagedTransition
+    {
+        std::function<void(StateMachineProxy&)> _call;
+        /// start priority instead of init priority decides the order
+        bool _by_start_priority;
+        /// lower priorities first (reverse transitions)
+        bool _ascending;
+        /// transition undoing this one for canaries if the canary stage fails
+        std::string _rollback;
+        /// states a participant may be in before the transition
+        std::vector<ParticipantState> _sources;
+        /// state after the transition, participants already in it are skipped
+        ParticipantState _target;
+    };
+
+    const std::map<std::string, StagedTransition> staged_transitions = {
+        { "load", { [](StateMachineProxy& sm) { sm->load(); }, false, false, "unload",
+            { ParticipantState::unloaded }, ParticipantState::loaded } },
+        { "unload", { [](StateMachineProxy& sm) { sm->unload(); }, false, true, "load",
+            { ParticipantState::loaded }, ParticipantState::unloaded } },
+        { "initialize", { [](StateMachineProxy& sm) { sm->initialize(); }, false, false, "deinitialize",
+            { ParticipantState::loaded }, ParticipantState::initialized } },
+        { "deinitialize", { [](StateMachineProxy& sm) { sm->deinitialize(); }, false, true, "initialize",
+            { ParticipantState::initialized }, ParticipantState::loaded } },
+        { "start", { [](StateMachineProxy& sm) { sm->start(); }, true, false, "stop",
+            { ParticipantState::initialized, ParticipantState::paused }, ParticipantState::running } },
+        { "stop", { [](StateMachineProxy& sm) { sm->stop(); }, true, true, "start",
+            { ParticipantState::running, ParticipantState::paused }, ParticipantState::initialized } },
+        { "pause", { [](StateMachineProxy& sm) { sm->pause(); }, true, false, "",
+            { ParticipantState::initialized, ParticipantState::running }, ParticipantState::paused } }
+    };
+
+    //0 disables the staged canary transitions
+    std::atomic<size_t> canary_count(0u);
+    std::atomic<size_t> staged_concurrency(8u);
+
+    const size_t property_concurrency = 16u;
+
+    //checks the timing configuration of a system before starting it
+    std::atomic<bool> timing_preflight_enabled(false);
+
+    static std::string getStateName(ParticipantState state)
+    {
+        const auto name = system_state_table::getName(state);
+        return std::string(name._data, name._size);
+    }
+
+    /// groups by priority, by name within a group so the canaries do not depend on the discovery order
+    static std::vector<std::vector<fep3::ParticipantProxy>> groupByPriority(std::vector<fep3::ParticipantProxy> participants,
+        const StagedTransition& transition)
+    {
+        auto priority = [&transition](const fep3::ParticipantProxy& participant)
+        {
+            return transition._by_start_priority ? participant.getStartPriority() : participant.getInitPriority();
+        };
+        std::sort(participants.begin(), participants.end(),
+            [&](const fep3::ParticipantProxy& lhs, const fep3::ParticipantProxy& rhs)
+            {
+                if (priority(lhs) != priority(rhs))
+                {
+                    return transition._ascending ? priority(lhs) < priority(rhs) : priority(lhs) > priority(rhs);
+                }
+                return lhs.getName() < rhs.getName();
+            });
+        std::vector<std::vector<fep3::ParticipantProxy>> groups;
+        for (auto& participant : participants)
+        {
+            if (groups.empty() || priority(groups.back().front()) != priority(participant))
+            {
+                groups.emplace_back();
+            }
+            groups.back().push_back(std::move(participant));
+        }
+        return groups;
+    }
+
+    /// transitions all @p participants concurrently, returns one error message per participant (empty on success)
+    static std::vector<std::string> transitionParticipants(const std::string& system_name,
+        std::vector<fep3::ParticipantProxy>& participants,
+        const std::string& transition_name)
+    {
+        const auto& transition = staged_transitions.at(transition_name);
+        std::vector<std::string> errors(participants.size());
+        worker_pool::parallelFor(participants.size(), staged_concurrency,
+            [&](size_t index)
+            {
+                const std::string participant_name = participants[index].getName();
+                try
+                {
+                    auto state_machine = participants[index].getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantStateMachine>();
+                    if (!state_machine)
+                    {
+                        errors[index] = participant_name + " has no state machine";
+                        return;
+                    }
+                    transition_statistics::measure(transition_stats, system_name, participant_name, transition_name,
+                        [&]()
+                        {
+                            transition._call(state_machine);
+                        });
+                    const auto state = state_machine->getState();
+                    if (state != transition._target)
+                    {
+                        errors[index] = participant_name + " is " + getStateName(state) + " after " + transition_name;
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    errors[index] = participant_name + ": " + e.what();
+                }
+            });
+        return errors;
+    }
+
+    static std::string joinErrors(const std::vector<std::string>& errors)
+    {
+        std::vector<std::string> failed;
+        std::copy_if(errors.begin(), errors.end(), std::back_inserter(failed),
+            [](const std::string& error) { return !error.empty(); });
+        return a_util::strings::join(failed, "; ");
+    }
+
+    /**
+     * Reads the states of all @p participants concurrently and returns the ones not yet in the target state,
+     * so a partially done transition can be finished by running it again.
+     * Throws std::runtime_error if a participant is neither in a source nor in the target state.
+     */
+    static std::vector<fep3::ParticipantProxy> selectPendingParticipants(std::vector<fep3::ParticipantProxy> participants,
+        const std::string& transition_name)
+    {
+        const auto& transition = staged_transitions.at(transition_name);
+        std::vector<ParticipantState> states(participants.size(), transition._target);
+        std::vector<std::string> errors(participants.size());
+        worker_pool::parallelFor(participants.size(), staged_concurrency,
+            [&](size_t index)
+            {
+                const std::string participant_name = participants[index].getName();
+                try
+                {
+                    auto state_machine = participants[index].getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantStateMachine>();
+                    if (!state_machine)
+                    {
+                        errors[index] = participant_name + " has no state machine";
+                        return;
+                    }
+                    states[index] = state_machine->getState();
+                    if (states[index] != transition._target
+                        && std::find(transition._sources.begin(), transition._sources.end(), states[index]) == transition._sources.end())
+                    {
+                        errors[index] = participant_name + " is " + getStateName(states[index]);
+                    }
+                }
+                catch (const std::exception& e)
+                {
+                    errors[index] = participant_name + ": " + e.what();
+                }
+            });
+        const auto failure = joinErrors(errors);
+        if (!failure.empty())
+        {
+            throw std::runtime_error("participants cannot " + transition_name + " (" + failure + "), no participant was touched");
+        }
+        std::vector<fep3::ParticipantProxy> pending;
+        for (size_t index = 0u; index < participants.size(); ++index)
+        {
+            if (states[index] != transition._target)
+            {
+                pending.push_back(std::move(participants[index]));
+            }
+        }
+        return pending;
+    }
+
+    /**
+     * Transitions the participants of @p system one by one priority group, each group concurrently
+     * with at most staged_concurrency workers. Participants already in the target state are skipped.
+     * The first canary_count participants of the first group go first; if one of them fails the others
+     * are rolled back and no other participant is touched.
+     * Throws std::runtime_error with the collected participant errors.
+     */
+    static void transitionSystemStaged(const std::string& system_name, fep3::System& system, const std::string& transition_name)
+    {
+        const auto& transition = staged_transitions.at(transition_name);
+        auto groups = groupByPriority(selectPendingParticipants(system.getParticipants(), transition_name), transition);
+        if (groups.empty())
+        {
+            return;
+        }
+
+        auto& first_group = groups.front();
+        const auto canary_end = first_group.begin() + std::min<size_t>(canary_count, first_group.size());
+        std::vector<fep3::ParticipantProxy> canaries(first_group.begin(), canary_end);
+        first_group.erase(first_group.begin(), canary_end);
+
+        const auto canary_errors = transitionParticipants(system_name, canaries, transition_name);
+        const auto canary_failure = joinErrors(canary_errors);
+        if (!canary_failure.empty())
+        {
+            std::vector<fep3::ParticipantProxy> succeeded_canaries;
+            for (size_t index = 0u; index < canaries.size(); ++index)
+            {
+                if (canary_errors[index].empty())
+                {
+                    succeeded_canaries.push_back(canaries[index]);
+                }
+            }
+            std::string rollback_failure;
+            if (!transition._rollback.empty())
+            {
+                rollback_failure = joinErrors(transitionParticipants(system_name, succeeded_canaries, transition._rollback));
+            }
+            size_t untouched = 0u;
+            for (const auto& group : groups)
+            {
+                untouched += group.size();
+            }
+            throw std::runtime_error("canary stage failed (" + canary_failure + "), " + std::to_string(untouched)
+                + " participants were not touched" + (rollback_failure.empty() ? "" : ", rollback failed (" + rollback_failure + ")"));
+        }
+
+        for (auto& group : groups)
+        {
+            const auto failure = joinErrors(transitionParticipants(system_name, group, transition_name));
+            if (!failure.empty())
+            {
+                throw std::runtime_error(failure);
+            }
+        }
+    }
+
+    typedef std::function<bool(system_registry::SystemEntry& entry, std::ostream& out)> SystemOperation;
+    typedef std::function<void(const system_registry::SystemHandle& entry)> SystemCallback;
+
+    static bool isSystemPattern(const std::string& name)
+    {
+        return name.find_first_of("*?,") != std::string::npos;
+    }
+
+    static std::vector<std::string> resolveSystemPattern(const std::string& pattern)
+    {
+        std::vector<std::string> system_names;
+        auto add_name = [&system_names](const std::string& name)
+        {
+            if (std::find(system_names.begin(), system_names.end(), name) == system_names.end())
+            {
+                system_names.push_back(name);
+            }
+        };
+        for (const auto& element : a_util::strings::split(pattern, ","))
+        {
+            if (element.find_first_of("*?") == std::string::npos)
+            {
+                //plain names are resolved later (and maybe auto discovered)
+                add_name(element);
+                continue;
+            }
+            for (const auto& system_name : connected_or_discovered_systems.getNames())
+            {
+                if (matchesWildcard(element, system_name))
+                {
+                    add_name(system_name);
+                }
+            }
+        }
+        return system_names;
+    }
+
+    /**
+     * Runs @p operation concurrently (one worker per system) on all systems matching @p pattern
+     * (comma separated list of names and glob patterns). The output of each system is collected
+     * and printed in order after all workers are done, followed by "<n> of <m> systems <summary>".
+     * Plain names that cannot be resolved count as failed systems.
+     * Each operation holds the operation lock of its system.
+     * @p on_success is called on the calling thread for each system the operation succeeded for.
+     */
+    static bool forEachMatchingSystem(const std::string& pattern,
+        const SystemOperation& operation,
+        const std::string& summary,
+        const SystemCallback& on_success = nullptr)
+    {
+        std::vector<system_registry::SystemHandle> targets;
+        size_t unresolved = 0u;
+        for (const auto& system_name : resolveSystemPattern(pattern))
+        {
+            auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+            if (entry)
+            {
+                targets.push_back(entry);
+            }
+            else
+            {
+                ++unresolved;
+            }
+        }
+        if (targets.empty() && unresolved == 0u)
+        {
+            std::cout << "no system matches \"" << pattern << "\"" << std::endl;
+            return false;
+        }
+
+        std::vector<std::ostringstream> outputs(targets.size());
+        std::vector<char> results(targets.size(), 0);
+        worker_pool::parallelFor(targets.size(), targets.size(),
+            [&](size_t index)
+            {
+                std::lock_guard<std::mutex> operation_lock(targets[index]->_operation_mutex);
+                results[index] = operation(*targets[index], outputs[index]);
+            });
+
+        size_t succeeded = 0u;
+        for (size_t index = 0u; index < targets.size(); ++index)
+        {
+            std::cout << outputs[index].str();
+            if (results[index])
+            {
+                ++succeeded;
+                if (on_success)
+                {
+                    on_success(targets[index]);
+                }
+            }
+        }
+        if (!summary.empty())
+        {
+            std::cout << succeeded << " of " << targets.size() + unresolved << " systems " << summary << std::endl;
+        }
+        return unresolved == 0u && succeeded == targets.size();
+    }
+
+    /// prints every problem of the timing configuration of the system and returns whether there is none
+    static bool passesTimingPreflight(system_registry::SystemEntry& entry, std::ostream& out)
+    {
+        std::vector<std::string> participant_names;
+        for (const auto& participant : entry._system.getParticipants())
+        {
+            participant_names.push_back(participant.getName());
+        }
+        std::sort(participant_names.begin(), participant_names.end());
+        const auto problems = timing_preflight::check(
+            timing_preflight::read(entry._system, entry._proxies, participant_names, property_concurrency));
+        for (const auto& problem : problems)
+        {
+            out << "timing preflight of \"" << entry._name << "\": " << problem << std::endl;
+        }
+        return problems.empty();
+    }
+
+    /// runs the timing preflight if enabled, for every command that starts participants
+    static bool passesEnabledTimingPreflight(system_registry::SystemEntry& entry, std::ostream& out)
+    {
+        return !timing_preflight_enabled || passesTimingPreflight(entry, out);
+    }
+
+    static bool changeStateOfSystem(system_registry::SystemEntry& entry,
+        const std::function<void(fep3::System& system)>& call,
         const std::string& success_message,
-        const std::string& failed_message)
+        const std::string& failed_message,
+        bool check_timing,
+        std::ostream& out)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        const std::string& system_name = entry._name;
+        fep3::System& system = entry._system;
+        if (check_timing && !passesEnabledTimingPreflight(entry, out))
         {
+            out << "cannot start system \"" << system_name << "\", the timing preflight failed" << std::endl;
             return false;
         }
         try
         {
-            call(it->second);
+            transition_statistics::measure(transition_stats, system_name, "", failed_message,
+                [&]()
+                {
+                    if (canary_count > 0u && staged_transitions.count(failed_message) != 0u)
+                    {
+                        transitionSystemStaged(system_name, system, failed_message);
+                    }
+                    else
+                    {
+                        call(system);
+                    }
+                });
         }
         catch (const std::exception& e)
         {
-            std::cout << "cannot " << failed_message << " system \"" << *first << "\", error: " << e.what() << std::endl;
+            out << "cannot " << failed_message << " system \"" << system_name << "\", error: " << e.what() << std::endl;
+            return false;
+        }
+        out << system_name << " " << success_message << std::endl;
+        return true;
+    }
+
+    static bool changeStateMethod(
+        TokenIterator first,
+        std::function<void(fep3::System& system)> call,
+        const std::string& success_message,
+        const std::string& failed_message,
+        const SystemCallback& on_success = nullptr,
+        bool check_timing = false)
+    {
+        if (isSystemPattern(*first))
+        {
+            return forEachMatchingSystem(*first,
+                [&](system_registry::SystemEntry& entry, std::ostream& out)
+                {
+                    return changeStateOfSystem(entry, call, success_message, failed_message, check_timing, out);
+                },
+                success_message, on_success);
+        }
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        if (!changeStateOfSystem(*entry, call, success_message, failed_message, check_timing, std::cout))
+        {
             return false;
         }
-        std::cout << *first << " " << success_message << std::endl;
+        if (on_success)
+        {
+            on_success(entry);
+        }
         return true;
     }
 
@@ -523,7 +1044,9 @@ namespace
                 sys.start(); 
             },
             "started",
-            "start");
+            "start",
+            nullptr,
+            true);
     }
     static bool stopSystem(TokenIterator first, TokenIterator)
     {
@@ -591,55 +1114,57 @@ namespace
         return changeStateMethod(first,
             [](fep3::System& sys)
             {
-                std::string name = sys.getSystemName();
                 sys.shutdown();
-                connected_or_discovered_systems.erase(name);
             },
             "shutdowned",
-            "shutdown");
+            "shutdown",
+            [](const system_registry::SystemHandle& entry)
+            {
+                //jobs still holding the entry can finish with it
+                if (connected_or_discovered_systems.erase(entry))
+                {
+                    stopConfigurationWatcher(entry->_name);
+                }
+            });
     }
 
     static bool startMonitoringSystem(TokenIterator first, TokenIterator)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
-        else
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        try
         {
-            try
-            {
-                it->second.unregisterMonitoring(monitor);
-            }
-            catch (const std::exception&)
-            {
-                //...
-            }
-            it->second.registerMonitoring(monitor);
-            return true;
+            entry->_system.unregisterMonitoring(monitor);
+        }
+        catch (const std::exception&)
+        {
+            //...
         }
+        entry->_system.registerMonitoring(monitor);
+        return true;
     }
 
     static bool stopMonitoringSystem(TokenIterator first, TokenIterator)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
-        else
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        try
         {
-            try
-            {
-                it->second.unregisterMonitoring(monitor);
-            }
-            catch (const std::exception&)
-            {
-                //...
-            }
-            return true;
+            entry->_system.unregisterMonitoring(monitor);
+        }
+        catch (const std::exception&)
+        {
+            //...
         }
+        return true;
     }
 
     static bool doParticipantStateChange(TokenIterator& first,
@@ -647,22 +1172,27 @@ namespace
                                          const std::string& message_1,
                                          const std::string& message_2)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         std::string partname = "";
         try
         {
             partname = *std::next(first);
-            auto part = it->second.getParticipant(partname);
+            auto part = entry->_proxies.getParticipant(entry->_system, partname);
             if (part)
             {
-                auto state_machine = part.getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantStateMachine>();
+                auto state_machine = entry->_proxies.getComponent<fep3::rpc::arya::IRPCParticipantStateMachine>(entry->_system, partname);
                 if (state_machine)
                 {
-                    change_state(state_machine);
+                    transition_statistics::measure(transition_stats, entry->_name, partname, message_1,
+                        [&]()
+                        {
+                            change_state(state_machine);
+                        });
                 }
                 else
                 {
@@ -675,11 +1205,17 @@ namespace
                 std::cout << "participant \"" << partname << "\" is not in system \"" << *first << "\"" << std::endl;
                 return false;
             }
+            if (message_1 == "shutdown")
+            {
+                entry->_proxies.invalidate(partname);
+            }
             //this updates for completion
-            last_system_name_used = it->first;
+            connected_or_discovered_systems.setLastUsedName(entry->_name);
         }
         catch (const std::exception& e)
         {
+            //the cached proxies might belong to a participant that is gone
+            entry->_proxies.invalidate(partname);
             std::cout << "cannot " << message_1 << " participant \"" << partname << "@" << *first << "\", error: " << e.what() << std::endl;
             return false;
         }
@@ -752,103 +1288,905 @@ namespace
         }, "shutdown", "shutdowned");
     }
 
-    static bool getSystemState(TokenIterator first, TokenIterator)
+    static bool printSystemState(const std::string& system_name, fep3::System& system, std::ostream& out)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
-        {
-            return false;
-        }
         try
         {
-            auto state = it->second.getSystemState();
-            std::cout << int(state._state) << " - " << resolveSystemState(state._state) 
-                << " - homogeneous : " << state._homogeneous << std::endl;
+            auto state = system.getSystemState();
+            system_state_table::writeLine(out, state._state);
+            out << " - homogeneous : " << state._homogeneous << std::endl;
         }
         catch (const std::exception& e)
         {
-            std::cout << "cannot get system state for \"" << *first << "\", error: " << e.what() << std::endl;
+            out << "cannot get system state for \"" << system_name << "\", error: " << e.what() << std::endl;
             return false;
         }
         return true;
     }
-    static bool setSystemState(TokenIterator first, TokenIterator last)
-    {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+
+    static bool getSystemState(TokenIterator first, TokenIterator)
+    {
+        if (isSystemPattern(*first))
+        {
+            return forEachMatchingSystem(*first,
+                [](system_registry::SystemEntry& entry, std::ostream& out)
+                {
+                    out << entry._name << " - ";
+                    return printSystemState(entry._name, entry._system, out);
+                },
+                "");
+        }
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        return printSystemState(*first, entry->_system, std::cout);
+    }
+    static bool setSystemState(TokenIterator first, TokenIterator last)
+    {
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
         std::string state_string = *std::next(first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry || !isSettableState(state_string))
         {
             return false;
         }
-        try
+        bool shutdown = false;
         {
-            auto state_to_set = getStateFromString(state_string);
-            if (state_to_set == fep3::SystemAggregatedState::unreachable)
+            std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+            try
             {
-                it->second.setSystemState(fep3::SystemAggregatedState::unloaded);
-                return shutdownSystem(first, last);
+                auto state_to_set = getStateFromString(state_string);
+                if (state_to_set == fep3::SystemAggregatedState::running
+                    && !passesEnabledTimingPreflight(*entry, std::cout))
+                {
+                    std::cout << "cannot set system state \"" + state_string + "\" for \"" << *first
+                        << "\", the timing preflight failed" << std::endl;
+                    return false;
+                }
+                if (state_to_set == fep3::SystemAggregatedState::unreachable)
+                {
+                    entry->_system.setSystemState(fep3::SystemAggregatedState::unloaded);
+                    shutdown = true;
+                }
+                else
+                {
+                    entry->_system.setSystemState(state_to_set);
+                }
             }
-            else
+            catch (const std::exception& e)
             {
-                it->second.setSystemState(state_to_set);
-                getSystemState(first, last);
+                std::cout << "cannot set system state \"" + state_string + "\" for \"" << *first << "\", error: " << e.what() << std::endl;
+                return false;
             }
-            
+        }
+        //both lock the system on their own
+        if (shutdown)
+        {
+            return shutdownSystem(first, last);
+        }
+        getSystemState(first, last);
+        return true;
+    }
+    static bool getParticipants(TokenIterator first, TokenIterator)
+    {
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        dumpSystemParticipants(entry->_system);
+        return true;
+    }
+
+    static bool loadPropertyFile(const std::string& file_name, system_properties::PropertyFile& property_file)
+    {
+        try
+        {
+            property_file = compiled_properties.load(file_name);
         }
         catch (const std::exception& e)
         {
-            std::cout << "cannot set system state \"" + state_string + "\" for \"" << *first << "\", error: " << e.what() << std::endl;
+            std::cout << "cannot read properties file \"" << file_name << "\", error: " << e.what() << std::endl;
             return false;
         }
         return true;
     }
-    static bool getParticipants(TokenIterator first, TokenIterator)
+
+    /**
+     * The timing configuration is not a set of participant properties, the controller translates it into
+     * timing calls. So it gets a file with only the timing section, to be called with the operation lock held.
+     */
+    static bool configureTimingProperties(system_registry::SystemEntry& entry,
+        const std::string& file_name,
+        const std::vector<system_properties::Property>& timing_properties)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        entry._applied_timing_properties.clear();
+        //not next to the file of the user, its directory may be read only or watched
+        const auto timing_file_name = cache_files::getTemporaryFileName("fep_control_timing");
+        try
         {
+            system_properties::writeTimingFile(timing_file_name, timing_properties);
+            fep3::controller::configureSystemProperties(entry._system, timing_file_name);
+        }
+        catch (const std::exception& e)
+        {
+            std::remove(timing_file_name.c_str());
+            std::cout << "cannot set timing properties for \"" << entry._name << "\" from file \"" << file_name << "\", error: " << e.what() << std::endl;
             return false;
         }
-        dumpSystemParticipants(it->second);
+        std::remove(timing_file_name.c_str());
+        entry._applied_timing_properties = timing_properties;
         return true;
     }
-    static bool configureSystem(TokenIterator first, TokenIterator)
+
+    /// resolves the properties of all participants, returns false if the file names participants which are not in the system
+    static bool resolveProperties(system_registry::SystemEntry& entry,
+        const std::string& file_name,
+        const system_properties::PropertyFile& property_file,
+        std::map<std::string, std::vector<system_properties::Property>>& properties)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        bool success = true;
+        std::vector<std::string> participant_names;
+        for (const auto& participant : entry._system.getParticipants())
+        {
+            participant_names.push_back(participant.getName());
+        }
+        for (const auto& element : property_file._element_properties)
         {
+            if (std::find(participant_names.begin(), participant_names.end(), element.first) == participant_names.end())
+            {
+                std::cout << "participant \"" << element.first << "\" of \"" << file_name << "\" is not in system \"" << entry._name << "\"" << std::endl;
+                success = false;
+            }
+        }
+        properties = system_properties::resolve(property_file, participant_names);
+        return success;
+    }
+
+    /// prints the failures per participant, returns false if there were any
+    static bool reportPushResults(const std::string& system_name, const std::vector<system_properties::PushResult>& results)
+    {
+        bool success = true;
+        for (const auto& result : results)
+        {
+            if (!result._failed.empty())
+            {
+                std::cout << "participant \"" << result._name << "@" << system_name << "\" refused the properties "
+                    << a_util::strings::join(result._failed, ", ") << std::endl;
+                success = false;
+            }
+            if (!result._error.empty())
+            {
+                std::cout << "cannot set properties of participant \"" << result._name << "@" << system_name
+                    << "\", error: " << result._error << std::endl;
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    /// sets all properties of the file, to be called with the operation lock held
+    static bool configureSystemFull(system_registry::SystemEntry& entry, const std::string& file_name)
+    {
+        system_properties::PropertyFile property_file;
+        if (!loadPropertyFile(file_name, property_file))
+        {
+            entry._applied_timing_properties.clear();
             return false;
         }
+        bool success = true;
+        if (!property_file._timing_properties.empty())
+        {
+            success = configureTimingProperties(entry, file_name, property_file._timing_properties);
+        }
+        std::map<std::string, std::vector<system_properties::Property>> properties;
+        success = resolveProperties(entry, file_name, property_file, properties) && success;
+
+        size_t total = 0u;
+        for (const auto& participant : properties)
+        {
+            total += participant.second.size();
+        }
+        if (total == 0u)
+        {
+            return success;
+        }
+        const auto results = system_properties::push(entry._system, entry._proxies, properties, property_concurrency);
+        size_t set = 0u;
+        size_t participants = 0u;
+        for (const auto& result : results)
+        {
+            set += result._set;
+            participants += result._set == 0u ? 0u : 1u;
+        }
+        std::cout << set << " of " << total << " properties set on " << participants << " participants" << std::endl;
+        return reportPushResults(entry._name, results) && success;
+    }
+
+    /// reads the current values and sets only the properties which differ, to be called with the operation lock held
+    static bool pushChangedProperties(system_registry::SystemEntry& entry,
+        const std::map<std::string, std::vector<system_properties::Property>>& properties)
+    {
+        const auto deltas = system_properties::computeDelta(entry._system, entry._proxies, properties, property_concurrency);
+
+        std::map<std::string, std::vector<system_properties::Property>> changed_properties;
+        size_t changed = 0u;
+        size_t total = 0u;
+        for (const auto& delta : deltas)
+        {
+            if (!delta._error.empty())
+            {
+                std::cout << "cannot read properties of participant \"" << delta._name << "@" << entry._name
+                    << "\", setting all of them, error: " << delta._error << std::endl;
+            }
+            changed += delta._changed.size();
+            total += delta._changed.size() + delta._unchanged;
+            if (!delta._changed.empty())
+            {
+                changed_properties[delta._name] = delta._changed;
+            }
+        }
+        const auto results = system_properties::push(entry._system, entry._proxies, changed_properties, property_concurrency);
+        std::cout << changed << " of " << total << " properties changed on " << changed_properties.size() << " participants" << std::endl;
+        return reportPushResults(entry._name, results);
+    }
+
+    /// sets only the properties whose current value differs, to be called with the operation lock held
+    static bool configureSystemDelta(system_registry::SystemEntry& entry, const std::string& file_name)
+    {
+        system_properties::PropertyFile property_file;
+        if (!loadPropertyFile(file_name, property_file))
+        {
+            return false;
+        }
+        bool success = true;
+        if (!property_file._timing_properties.empty()
+            && property_file._timing_properties != entry._applied_timing_properties)
+        {
+            std::cout << "timing properties changed" << std::endl;
+            success = configureTimingProperties(entry, file_name, property_file._timing_properties);
+        }
+        std::map<std::string, std::vector<system_properties::Property>> properties;
+        success = resolveProperties(entry, file_name, property_file, properties) && success;
+        return pushChangedProperties(entry, properties) && success;
+    }
+
+    static bool configureSystem(TokenIterator first, TokenIterator last)
+    {
+        const std::string file_name = *std::next(first);
+        const std::string mode = std::next(first, 2) != last ? *std::next(first, 2) : "full";
+        if (mode != "full" && mode != "delta")
+        {
+            std::cout << "invalid mode \"" << mode << "\", use full or delta" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        return mode == "delta" ? configureSystemDelta(*entry, file_name) : configureSystemFull(*entry, file_name);
+    }
+
+    /// participants of the system matching a name or glob pattern, sorted by name, to be called with the operation lock held
+    static std::vector<std::string> getMatchingParticipants(system_registry::SystemEntry& entry, const std::string& pattern)
+    {
+        std::vector<std::string> participant_names;
+        for (const auto& participant : entry._system.getParticipants())
+        {
+            if (matchesWildcard(pattern, participant.getName()))
+            {
+                participant_names.push_back(participant.getName());
+            }
+        }
+        std::sort(participant_names.begin(), participant_names.end());
+        if (participant_names.empty())
+        {
+            std::cout << "no participant of system \"" << entry._name << "\" matches \"" << pattern << "\"" << std::endl;
+        }
+        return participant_names;
+    }
+
+    static bool getProperties(TokenIterator first, TokenIterator)
+    {
+        const std::string path_pattern = *std::next(first, 2);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        const auto participant_names = getMatchingParticipants(*entry, *std::next(first));
+        if (participant_names.empty())
+        {
+            return false;
+        }
+        //results are printed as soon as a participant is done, one line per property
+        std::mutex output_mutex;
+        bool success = true;
+        system_properties::get(entry->_system, entry->_proxies, participant_names, path_pattern, property_concurrency,
+            [&](const std::string& participant_name, const std::vector<system_properties::Property>& properties, const std::string& error)
+            {
+                std::ostringstream lines;
+                for (const auto& property : properties)
+                {
+                    lines << participant_name << " " << property._path << " " << property._type << " " << property._value << "\n";
+                }
+                if (!error.empty())
+                {
+                    lines << "cannot get properties of participant \"" << participant_name << "@" << entry->_name << "\", error: " << error << "\n";
+                }
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << lines.str() << std::flush;
+                success = success && error.empty();
+            });
+        return success;
+    }
+
+    static bool setProperties(TokenIterator first, TokenIterator last)
+    {
+        std::vector<std::pair<std::string, std::string>> values;
+        for (auto assignment = std::next(first, 2); assignment != last; ++assignment)
+        {
+            const auto separator = assignment->find('=');
+            if (separator == std::string::npos || separator == 0u)
+            {
+                std::cout << "invalid assignment \"" << *assignment << "\", use <property path>=<value>" << std::endl;
+                return false;
+            }
+            values.emplace_back(assignment->substr(0u, separator), assignment->substr(separator + 1u));
+        }
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        const auto participant_names = getMatchingParticipants(*entry, *std::next(first));
+        if (participant_names.empty())
+        {
+            return false;
+        }
+        std::mutex output_mutex;
+        bool success = true;
+        system_properties::set(entry->_system, entry->_proxies, participant_names, values, property_concurrency,
+            [&](const system_properties::PushResult& result)
+            {
+                std::lock_guard<std::mutex> lock(output_mutex);
+                std::cout << result._name << " " << result._set << " of " << values.size() << " properties set" << std::endl;
+                success = reportPushResults(entry->_name, { result }) && success;
+            });
+        return success;
+    }
+
+    static bool transitionStats(TokenIterator first, TokenIterator last)
+    {
+        if (transition_stats.empty())
+        {
+            std::cout << "no transitions recorded" << std::endl;
+        }
+        else
+        {
+            transition_stats.dump(std::cout);
+        }
+        if (first != last)
+        {
+            std::ofstream csv_file(*first);
+            if (!csv_file)
+            {
+                std::cout << "cannot open file \"" << *first << "\" for writing" << std::endl;
+                return false;
+            }
+            transition_stats.writeCsv(csv_file);
+        }
+        return true;
+    }
+
+    const std::map<std::string, std::function<void(fep3::System&)>> cycle_transitions = {
+        { "load", [](fep3::System& sys) { sys.load(); } },
+        { "initialize", [](fep3::System& sys) { sys.initialize(); } },
+        { "start", [](fep3::System& sys) { sys.start(); } },
+        { "pause", [](fep3::System& sys) { sys.pause(); } },
+        { "stop", [](fep3::System& sys) { sys.stop(); } },
+        { "deinitialize", [](fep3::System& sys) { sys.deinitialize(); } },
+        { "unload", [](fep3::System& sys) { sys.unload(); } }
+    };
+    const std::vector<std::string> default_cycle = { "load", "initialize", "start", "stop", "deinitialize", "unload" };
+
+    static bool parseCount(const std::string& value, size_t& count)
+    {
+        if (value.empty() || !std::isdigit(value[0]))
+        {
+            return false;
+        }
+        char* end = nullptr;
+        errno = 0;
+        const auto parsed = std::strtoull(value.c_str(), &end, 10);
+        if (*end != '\0' || errno == ERANGE || parsed > std::numeric_limits<size_t>::max())
+        {
+            return false;
+        }
+        count = static_cast<size_t>(parsed);
+        return true;
+    }
+
+    /// signed difference of two memory sizes
+    static int64_t getGrowth(uint64_t start, uint64_t end)
+    {
+        return static_cast<int64_t>(end) - static_cast<int64_t>(start);
+    }
+
+    static void writeCycleReport(std::ostream& out,
+        const std::string& system_name,
+        const std::vector<std::string>& transitions,
+        size_t cycles_requested,
+        size_t cycles_completed,
+        double duration_s,
+        const std::vector<uint64_t>& rss_per_cycle,
+        const std::map<std::string, transition_statistics::LatencyHistogram>& latencies,
+        const std::string& error)
+    {
+        const uint64_t rss_start = rss_per_cycle.front();
+        const uint64_t rss_end = rss_per_cycle.back();
+        const uint64_t rss_peak = *std::max_element(rss_per_cycle.begin(), rss_per_cycle.end());
+        out << "{\n";
+        out << "  \"system\": \"" << escapeJsonString(system_name) << "\",\n";
+        out << "  \"transitions\": [";
+        for (size_t index = 0u; index < transitions.size(); ++index)
+        {
+            out << (index == 0u ? "\"" : ", \"") << transitions[index] << "\"";
+        }
+        out << "],\n";
+        out << "  \"cycles_requested\": " << cycles_requested << ",\n";
+        out << "  \"cycles_completed\": " << cycles_completed << ",\n";
+        out << "  \"duration_s\": " << duration_s << ",\n";
+        out << "  \"cycles_per_minute\": " << (duration_s > 0.0 ? cycles_completed * 60.0 / duration_s : 0.0) << ",\n";
+        out << "  \"rss_bytes\": { \"start\": " << rss_start << ", \"end\": " << rss_end
+            << ", \"peak\": " << rss_peak << ", \"growth\": " << getGrowth(rss_start, rss_end) << " },\n";
+        out << "  \"rss_per_cycle_bytes\": [";
+        for (size_t index = 1u; index < rss_per_cycle.size(); ++index)
+        {
+            out << (index == 1u ? "" : ", ") << rss_per_cycle[index];
+        }
+        out << "],\n";
+        out << "  \"transition_latency_us\": {";
+        bool first_transition = true;
+        for (const auto& latency : latencies)
+        {
+            const auto& histogram = latency.second;
+            out << (first_transition ? "\n" : ",\n");
+            first_transition = false;
+            out << "    \"" << latency.first << "\": { \"count\": " << histogram.getCount()
+                << ", \"min\": " << histogram.getMin().count()
+                << ", \"mean\": " << histogram.getMean().count()
+                << ", \"p50\": " << histogram.getPercentile(50.0).count()
+                << ", \"p95\": " << histogram.getPercentile(95.0).count()
+                << ", \"p99\": " << histogram.getPercentile(99.0).count()
+                << ", \"max\": " << histogram.getMax().count() << " }";
+        }
+        out << "\n  },\n";
+        out << "  \"error\": " << (error.empty() ? std::string("null") : "\"" + escapeJsonString(error) + "\"") << "\n";
+        out << "}\n";
+    }
+
+    static bool cycleSystem(TokenIterator first, TokenIterator last)
+    {
+        const std::string system_name = *first;
+        size_t cycles = 0u;
+        if (!parseCount(*std::next(first), cycles) || cycles == 0u)
+        {
+            std::cout << "invalid number of cycles \"" << *std::next(first) << "\"" << std::endl;
+            return false;
+        }
+        auto argument = std::next(first, 2);
+        std::vector<std::string> transitions = default_cycle;
+        if (argument != last)
+        {
+            transitions = a_util::strings::split(*argument, ",");
+            ++argument;
+        }
+        for (const auto& transition : transitions)
+        {
+            if (cycle_transitions.count(transition) == 0u)
+            {
+                std::cout << "invalid transition \"" << transition << "\", use a comma separated list of "
+                    << a_util::strings::join(default_cycle, ",") << ",pause" << std::endl;
+                return false;
+            }
+        }
+        const std::string report_file = argument != last ? *argument : "";
+
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        //the timing configuration does not change while cycling, it is checked once
+        if (std::find(transitions.begin(), transitions.end(), "start") != transitions.end()
+            && !passesEnabledTimingPreflight(*entry, std::cout))
+        {
+            std::cout << "cannot cycle system \"" << system_name << "\", the timing preflight failed" << std::endl;
+            return false;
+        }
+
+        std::map<std::string, transition_statistics::LatencyHistogram> latencies;
+        std::vector<uint64_t> rss_per_cycle = { process_memory::getResidentSetSize() };
+        std::string error;
+        size_t cycles_completed = 0u;
+        const auto begin = std::chrono::steady_clock::now();
+        while (cycles_completed < cycles && error.empty())
+        {
+            for (const auto& transition : transitions)
+            {
+                try
+                {
+                    latencies[transition].record(transition_statistics::measure(transition_stats, system_name, "", transition,
+                        [&]()
+                        {
+                            cycle_transitions.at(transition)(entry->_system);
+                        }));
+                }
+                catch (const std::exception& e)
+                {
+                    error = "cycle " + std::to_string(cycles_completed + 1u) + ": cannot " + transition + ", error: " + e.what();
+                    break;
+                }
+            }
+            if (error.empty())
+            {
+                ++cycles_completed;
+            }
+            rss_per_cycle.push_back(process_memory::getResidentSetSize());
+        }
+        const double duration_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+        if (!error.empty())
+        {
+            std::cout << "cycling system \"" << system_name << "\" aborted in " << error << std::endl;
+        }
+        const auto rss_growth = getGrowth(rss_per_cycle.front(), rss_per_cycle.back());
+        std::ostringstream summary;
+        summary << std::fixed << std::setprecision(3);
+        summary << system_name << " " << cycles_completed << " cycles in " << duration_s << " s, "
+            << (duration_s > 0.0 ? cycles_completed * 60.0 / duration_s : 0.0) << " cycles/min, rss growth "
+            << rss_growth / 1024 << " kB" << std::endl;
+        summary << "transition count p50[ms] p95[ms] p99[ms] max[ms]" << std::endl;
+        for (const auto& latency : latencies)
+        {
+            const auto& histogram = latency.second;
+            summary << latency.first << " " << histogram.getCount() << " "
+                << histogram.getPercentile(50.0).count() / 1000.0 << " "
+                << histogram.getPercentile(95.0).count() / 1000.0 << " "
+                << histogram.getPercentile(99.0).count() / 1000.0 << " "
+                << histogram.getMax().count() / 1000.0 << std::endl;
+        }
+        std::cout << summary.str();
+
+        if (!report_file.empty())
+        {
+            std::ofstream report(report_file);
+            if (!report)
+            {
+                std::cout << "cannot open file \"" << report_file << "\" for writing" << std::endl;
+                return false;
+            }
+            writeCycleReport(report, system_name, transitions, cycles, cycles_completed, duration_s,
+                rss_per_cycle, latencies, error);
+        }
+        return error.empty();
+    }
+
+    static std::string formatSeconds(std::chrono::steady_clock::duration duration)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << std::chrono::duration<double>(duration).count() << " s";
+        return out.str();
+    }
+
+    static std::string formatMilliseconds(std::chrono::steady_clock::duration duration)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << std::chrono::duration<double, std::milli>(duration).count() << " ms";
+        return out.str();
+    }
+
+    /// pushes the properties which differ from the last applied content of the file, called by the watcher thread
+    static void applyConfigurationChange(const system_registry::SystemHandle& entry,
+        const std::string& file_name,
+        system_properties::PropertyFile& applied)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        system_properties::PropertyFile property_file;
+        if (!loadPropertyFile(file_name, property_file))
+        {
+            return;
+        }
+        if (!property_file._timing_properties.empty()
+            && property_file._timing_properties != applied._timing_properties)
+        {
+            configureTimingProperties(*entry, file_name, property_file._timing_properties);
+        }
+        std::vector<std::string> participant_names;
+        for (const auto& participant : entry->_system.getParticipants())
+        {
+            participant_names.push_back(participant.getName());
+        }
+        const auto changed_properties = configuration_watcher::diff(applied, property_file, participant_names);
+        const auto results = system_properties::push(entry->_system, entry->_proxies, changed_properties, property_concurrency);
+        size_t changed = 0u;
+        for (const auto& participant : changed_properties)
+        {
+            changed += participant.second.size();
+        }
+        std::cout << "configuration of \"" << entry->_name << "\" updated from \"" << file_name << "\", " << changed
+            << " properties changed on " << changed_properties.size() << " participants in "
+            << formatMilliseconds(std::chrono::steady_clock::now() - begin) << std::endl;
+        reportPushResults(entry->_name, results);
+        applied = std::move(property_file);
+    }
+
+    static bool watchConfiguration(TokenIterator first, TokenIterator last)
+    {
+        const std::string system_name = *first;
+        size_t debounce_ms = 100u;
+        if (std::next(first, 2) != last && !parseCount(*std::next(first, 2), debounce_ms))
+        {
+            std::cout << "invalid debounce time \"" << *std::next(first, 2) << "\"" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        const std::string file_name = getAbsolutePath(*std::next(first));
+        auto applied = std::make_shared<system_properties::PropertyFile>();
+        {
+            std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+            //the running system is brought in line with the file once, after that only edits are pushed
+            if (!configureSystemDelta(*entry, file_name) || !loadPropertyFile(file_name, *applied))
+            {
+                return false;
+            }
+        }
+        std::unique_ptr<configuration_watcher::ConfigurationWatcher> watcher;
         try
         {
-            fep3::controller::configureSystemProperties(it->second, *std::next(first));
+            watcher.reset(new configuration_watcher::ConfigurationWatcher(file_name, std::chrono::milliseconds(debounce_ms),
+                [entry, file_name, applied]()
+                {
+                    console_output::Capture capture;
+                    applyConfigurationChange(entry, file_name, *applied);
+                }));
         }
         catch (const std::exception& e)
         {
-            std::cout << "cannot set properties for \"" << *first << "\" from file \"" << *std::next(first) << "\", error: " << e.what() << std::endl;
+            std::cout << "cannot watch \"" << file_name << "\", error: " << e.what() << std::endl;
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(configuration_watchers_mutex);
+            //the replaced watcher is stopped outside of the lock
+            watcher.swap(configuration_watchers[entry->_name]);
+        }
+        if (connected_or_discovered_systems.find(entry->_name) != entry)
+        {
+            //replaced meanwhile, the watcher was registered after the one of the old entry was stopped
+            stopConfigurationWatcher(entry->_name);
+            std::cout << "system \"" << entry->_name << "\" was replaced while starting to watch \"" << file_name << "\"" << std::endl;
+            return false;
+        }
+        std::cout << "watching \"" << file_name << "\" for system \"" << entry->_name << "\"" << std::endl;
+        return true;
+    }
+
+    static bool stopWatchingConfiguration(TokenIterator first, TokenIterator)
+    {
+        if (!stopConfigurationWatcher(*first))
+        {
+            std::cout << "no configuration is watched for system \"" << *first << "\"" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /// the properties of all participants are stored as element properties of a compiled properties file
+    static bool saveConfiguration(TokenIterator first, TokenIterator)
+    {
+        const std::string file_name = *std::next(first);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        system_properties::PropertyFile configuration;
+        std::mutex configuration_mutex;
+        size_t property_count = 0u;
+        bool success = true;
+        {
+            std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+            std::vector<std::string> participant_names;
+            for (const auto& participant : entry->_system.getParticipants())
+            {
+                participant_names.push_back(participant.getName());
+            }
+            system_properties::getAll(entry->_system, entry->_proxies, participant_names, property_concurrency,
+                [&](const std::string& participant_name, const std::vector<system_properties::Property>& properties, const std::string& error)
+                {
+                    std::lock_guard<std::mutex> lock(configuration_mutex);
+                    if (!error.empty())
+                    {
+                        std::cout << "cannot get properties of participant \"" << participant_name << "@" << entry->_name << "\", error: " << error << std::endl;
+                        success = false;
+                        return;
+                    }
+                    configuration._element_properties[participant_name] = properties;
+                    property_count += properties.size();
+                });
+        }
+        //an incomplete configuration would be restored without notice
+        if (!success)
+        {
+            std::cout << "configuration of \"" << entry->_name << "\" not written to \"" << file_name << "\"" << std::endl;
+            return false;
+        }
+        if (!cache_files::writeFileAtomically(file_name, property_cache::compile(property_cache::SourceKey(), configuration)))
+        {
+            std::cout << "cannot write file \"" << file_name << "\"" << std::endl;
             return false;
         }
+        std::cout << property_count << " properties of " << configuration._element_properties.size() << " participants written to \""
+            << file_name << "\" in " << formatSeconds(std::chrono::steady_clock::now() - begin) << std::endl;
         return true;
     }
 
+    static bool restoreConfiguration(TokenIterator first, TokenIterator)
+    {
+        const std::string file_name = *std::next(first);
+        system_properties::PropertyFile configuration;
+        {
+            property_cache::SourceKey key;
+            const property_cache::MappedFile mapped(file_name);
+            if (mapped.getData() == nullptr
+                || !property_cache::decompile(mapped.getData(), mapped.getSize(), key, configuration))
+            {
+                std::cout << "\"" << file_name << "\" is no configuration written by saveConfiguration" << std::endl;
+                return false;
+            }
+        }
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        const auto begin = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        std::map<std::string, std::vector<system_properties::Property>> properties;
+        bool success = resolveProperties(*entry, file_name, configuration, properties);
+        success = pushChangedProperties(*entry, properties) && success;
+        std::cout << "restored in " << formatSeconds(std::chrono::steady_clock::now() - begin) << std::endl;
+        return success;
+    }
+
+    static void printJob(const job_control::JobInfo& job)
+    {
+        std::cout << "[" << job._id << "] " << job_control::toString(job._state) << " (" << formatSeconds(job._elapsed) << ") "
+            << job._command_line << std::endl;
+    }
+
+    /// background jobs run in parallel as long as they work on different systems
+    const size_t job_workers = 4u;
+    job_control::JobExecutor background_jobs([](const job_control::JobInfo& job)
+        {
+            console_output::Capture capture;
+            printJob(job);
+        }, job_workers);
+
+    static bool parseJobId(const std::string& value, uint32_t& id)
+    {
+        size_t parsed = 0u;
+        if (!parseCount(value, parsed) || parsed > UINT32_MAX)
+        {
+            std::cout << "invalid job id \"" << value << "\"" << std::endl;
+            return false;
+        }
+        id = static_cast<uint32_t>(parsed);
+        return true;
+    }
+
+    static bool listJobs(TokenIterator, TokenIterator)
+    {
+        const auto jobs = background_jobs.list();
+        if (jobs.empty())
+        {
+            std::cout << "no jobs" << std::endl;
+        }
+        for (const auto& job : jobs)
+        {
+            printJob(job);
+        }
+        return true;
+    }
+
+    static bool waitForJob(TokenIterator first, TokenIterator last)
+    {
+        if (first == last)
+        {
+            background_jobs.waitAll();
+            std::cout << "all jobs done" << std::endl;
+            return true;
+        }
+        uint32_t id = 0u;
+        if (!parseJobId(*first, id))
+        {
+            return false;
+        }
+        job_control::JobInfo job;
+        if (!background_jobs.wait(id, job))
+        {
+            std::cout << "no such job " << id << std::endl;
+            return false;
+        }
+        printJob(job);
+        return job._state == job_control::JobState::finished;
+    }
+
+    static bool cancelJob(TokenIterator first, TokenIterator)
+    {
+        uint32_t id = 0u;
+        if (!parseJobId(*first, id))
+        {
+            return false;
+        }
+        switch (background_jobs.cancel(id))
+        {
+            case job_control::CancelResult::cancelled:
+                std::cout << "[" << id << "] cancelled" << std::endl;
+                return true;
+            case job_control::CancelResult::running:
+                std::cout << "[" << id << "] is running and waits for a RPC, it cannot be cancelled" << std::endl;
+                return false;
+            case job_control::CancelResult::done:
+                std::cout << "[" << id << "] is already done" << std::endl;
+                return false;
+            default:
+                break;
+        }
+        std::cout << "no such job " << id << std::endl;
+        return false;
+    }
+
+    /// set by quit, the interactive loop ends after the command
+    std::atomic<bool> quit_requested(false);
+
     static bool quit(TokenIterator, TokenIterator)
     { 
         std::cout << "bye bye" << std::endl;
-        exit(0);
+        quit_requested = true;
+        return true;
     }
 
     static bool configureSystemTimingSystemTime(TokenIterator first, TokenIterator)
     {
         std::string system_name = *first;
         std::string master_name = *std::next(first);
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            it->second.configureTiming3ClockSyncOnlyInterpolation(master_name, "100");
+            entry->_applied_timing_properties.clear();
+            entry->_system.configureTiming3ClockSyncOnlyInterpolation(master_name, "100");
         }
         catch (const std::exception& e)
         {
@@ -864,14 +2202,16 @@ namespace
         std::string master_name = *(++first);
         std::string factor = *(++first);
         std::string step_size = *(++first);
-        auto it = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            it->second.configureTiming3DiscreteSteps(master_name, step_size, factor);
+            entry->_applied_timing_properties.clear();
+            entry->_system.configureTiming3DiscreteSteps(master_name, step_size, factor);
         }
         catch (const std::exception& e)
         {
@@ -884,16 +2224,18 @@ namespace
     static bool configureSystemTimeNoSync(TokenIterator first, TokenIterator)
     {
         std::string system_name = *first;
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
             //this updates for completion
-            last_system_name_used = system_name;
-            it->second.configureTiming3NoMaster();
+            connected_or_discovered_systems.setLastUsedName(system_name);
+            entry->_applied_timing_properties.clear();
+            entry->_system.configureTiming3NoMaster();
         }
         catch (const std::exception& e)
         {
@@ -906,14 +2248,15 @@ namespace
     static bool getCurrentTimingMaster(TokenIterator first, TokenIterator)
     {
         std::string system_name = *first;
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
-        if (it == connected_or_discovered_systems.end())
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto masters = it->second.getCurrentTimingMasters();
+            auto masters = entry->_system.getCurrentTimingMasters();
             auto masters_string = a_util::strings::join(masters, ",");
             std::cout << "timing masters: " << masters_string << std::endl;
         }
@@ -925,6 +2268,30 @@ namespace
         return true;
     }
 
+    static bool enableCanaryTransitions(TokenIterator first, TokenIterator last)
+    {
+        size_t count = 0u;
+        size_t concurrency = staged_concurrency;
+        if (!parseCount(*first, count) || count == 0u
+            || (std::next(first) != last && (!parseCount(*std::next(first), concurrency) || concurrency == 0u)))
+        {
+            std::cout << "invalid canary count or concurrency" << std::endl;
+            return false;
+        }
+        canary_count = count;
+        staged_concurrency = concurrency;
+        std::cout << "canary transitions: enabled (" << count << " canaries, "
+            << concurrency << " workers)" << std::endl;
+        return true;
+    }
+
+    static bool disableCanaryTransitions(TokenIterator, TokenIterator)
+    {
+        canary_count = 0u;
+        std::cout << "canary transitions: disabled" << std::endl;
+        return true;
+    }
+
     static bool enableAutoDiscovery(TokenIterator, TokenIterator)
     {
         auto_discovery_of_systems = true;
@@ -932,32 +2299,86 @@ namespace
         return true;
     }
 
-    static bool disableAutoDiscovery(TokenIterator, TokenIterator)
+    static bool disableAutoDiscovery(TokenIterator, TokenIterator)
+    {
+        auto_discovery_of_systems = false;
+        std::cout << "auto_discovery: disabled" << std::endl;
+        return true;
+    }
+
+    static bool enableBackgroundDiscovery(TokenIterator first, TokenIterator last)
+    {
+        size_t interval_ms = 5000u;
+        if (first != last && (!parseCount(*first, interval_ms) || interval_ms == 0u))
+        {
+            std::cout << "invalid interval \"" << *first << "\"" << std::endl;
+            return false;
+        }
+        if (!system_discoverer.start(std::chrono::milliseconds(interval_ms)))
+        {
+            std::cout << "background discovery is already enabled" << std::endl;
+            return false;
+        }
+        std::cout << "background discovery: enabled (every " << interval_ms << " ms)" << std::endl;
+        return true;
+    }
+
+    static bool disableBackgroundDiscovery(TokenIterator, TokenIterator)
+    {
+        system_discoverer.stop();
+        std::cout << "background discovery: disabled" << std::endl;
+        return true;
+    }
+
+    static bool waitForParticipantChanges(TokenIterator first, TokenIterator last)
     {
-        auto_discovery_of_systems = false;
-        std::cout << "auto_discovery: disabled" << std::endl;
+        size_t timeout_ms = 10000u;
+        if (first != last && !parseCount(*first, timeout_ms))
+        {
+            std::cout << "invalid timeout \"" << *first << "\"" << std::endl;
+            return false;
+        }
+        if (!system_discoverer.isRunning())
+        {
+            std::cout << "background discovery is not enabled" << std::endl;
+            return false;
+        }
+        std::vector<background_discovery::SystemDelta> deltas;
+        uint64_t generation = 0u;
+        if (!system_discoverer.waitForDeltas(seen_discovery_generation, std::chrono::milliseconds(timeout_ms), deltas, generation))
+        {
+            std::cout << "no participant changes within " << timeout_ms << " ms" << std::endl;
+            return false;
+        }
+        seen_discovery_generation = generation;
+        for (const auto& delta : deltas)
+        {
+            background_discovery::printDelta(std::cout, delta);
+        }
         return true;
     }
 
 
     static bool getParticipantState(TokenIterator first, TokenIterator)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
         std::string participant_name = *(++first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto part = it->second.getParticipant(participant_name);
+            auto part = entry->_proxies.getParticipant(entry->_system, participant_name);
             if (part)
             {
-                auto state_machine = part.getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantStateMachine>();
+                auto state_machine = entry->_proxies.getComponent<fep3::rpc::arya::IRPCParticipantStateMachine>(entry->_system, participant_name);
                 if (state_machine)
                 {
                     auto value = state_machine->getState();
-                    std::cout << int(value) << " - " << resolveSystemState(value) << std::endl;
+                    system_state_table::writeLine(std::cout, value);
+                    std::cout << std::endl;
                 }
                 else
                 {
@@ -973,6 +2394,7 @@ namespace
         }
         catch (const std::exception& e)
         {
+            entry->_proxies.invalidate(participant_name);
             std::cout << "cannot get participant state for participant \"" + participant_name  << "@" << *first << "\", error: " << e.what() << std::endl;
             return false;
         }
@@ -981,17 +2403,18 @@ namespace
 
     static bool setParticipantState(TokenIterator first, TokenIterator last)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
         std::string system_name = *first;
         std::string participant_name = *(++first);
         std::string state_string = *(++first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry || !isSettableState(state_string))
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto part = it->second.getParticipant(participant_name);
+            auto part = entry->_proxies.getParticipant(entry->_system, participant_name);
             if (part)
             {
                 //create a second temporary system with only one participant
@@ -999,16 +2422,27 @@ namespace
                 system_temp.add(participant_name);
 
                 auto state_to_set = getStateFromString(state_string);
+                //the participant joins the timing of the whole system, so the whole system is checked
+                if (state_to_set == fep3::SystemAggregatedState::running
+                    && !passesEnabledTimingPreflight(*entry, std::cout))
+                {
+                    std::cout << "cannot set participant state \"" << state_string << "\" for participant \"" << participant_name
+                        << "@" << system_name << "\", the timing preflight failed" << std::endl;
+                    return false;
+                }
                 if (state_to_set == fep3::SystemAggregatedState::unreachable)
                 {
                     system_temp.setSystemState(fep3::SystemAggregatedState::unloaded);
                     system_temp.shutdown();
-                    std::cout << int(state_to_set) << " - " << resolveSystemState(state_to_set) << std::endl;
+                    entry->_proxies.invalidate(participant_name);
+                    system_state_table::writeLine(std::cout, state_to_set);
+                    std::cout << std::endl;
                 }
                 else
                 {
                     system_temp.setSystemState(state_to_set);
-                    std::cout << int(state_to_set) << " - " << resolveSystemState(state_to_set) << std::endl;
+                    system_state_table::writeLine(std::cout, state_to_set);
+                    std::cout << std::endl;
                 }
             }
             else
@@ -1019,6 +2453,7 @@ namespace
         }
         catch (const std::exception& e)
         {
+            entry->_proxies.invalidate(participant_name);
             std::cout << "cannot set participant state" + state_string + "for participant \"" + participant_name << "@" << system_name << "\", error: " << e.what() << std::endl;
             return false;
         }
@@ -1028,18 +2463,19 @@ namespace
     bool getRPCObjectsParticipant(TokenIterator first, TokenIterator last)
     {
         std::string system_name = *(first);
-        auto it = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
         std::string participant_name = *std::next(first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto part = it->second.getParticipant(participant_name);
+            auto part = entry->_proxies.getParticipant(entry->_system, participant_name);
             if (part)
             {
-                auto info = part.getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantInfo>();
+                auto info = entry->_proxies.getComponent<fep3::rpc::arya::IRPCParticipantInfo>(entry->_system, participant_name);
                 if (info)
                 {
                     auto value = info->getRPCComponents();
@@ -1059,6 +2495,7 @@ namespace
         }
         catch (const std::exception& e)
         {
+            entry->_proxies.invalidate(participant_name);
             std::cout << "cannot get participant state for participant \"" + participant_name << "@" << system_name << "\", error: " << e.what() << std::endl;
             return false;
         }
@@ -1067,20 +2504,21 @@ namespace
 
     bool getRPCObjectIIDSParticipant(TokenIterator first, TokenIterator last)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
         std::string system_name = *(first);
         std::string participant_name = *(++first);
         std::string object_name = *(++first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto part = it->second.getParticipant(participant_name);
+            auto part = entry->_proxies.getParticipant(entry->_system, participant_name);
             if (part)
             {
-                auto info = part.getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantInfo>();
+                auto info = entry->_proxies.getComponent<fep3::rpc::arya::IRPCParticipantInfo>(entry->_system, participant_name);
                 if (info)
                 {
                     try
@@ -1090,6 +2528,7 @@ namespace
                     }
                     catch (const std::exception&)
                     {
+                        entry->_proxies.invalidate(participant_name);
                         std::cout << "participant \"" << participant_name << "@" << system_name << "\" IID info can not be retrieved " << std::endl;
                         return false;
                     }
@@ -1109,6 +2548,7 @@ namespace
         }
         catch (const std::exception& e)
         {
+            entry->_proxies.invalidate(participant_name);
             std::cout << "cannot get participant state for participant \"" + participant_name << "@" << system_name << "\", error: " << e.what() << std::endl;
             return false;
         }
@@ -1117,30 +2557,36 @@ namespace
 
     bool getRPCObjectDefinitionParticipant(TokenIterator first, TokenIterator last)
     {
-        auto it = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
         std::string system_name = *(first);
         std::string participant_name = *(++first);
         std::string object_name = *(++first);
         std::string intf_name = *(++first);
-        if (it == connected_or_discovered_systems.end())
+        if (!entry)
         {
             return false;
         }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
         try
         {
-            auto part = it->second.getParticipant(participant_name);
+            auto part = entry->_proxies.getParticipant(entry->_system, participant_name);
             if (part)
             {
-                auto info = part.getRPCComponentProxy<fep3::rpc::arya::IRPCParticipantInfo>();
+                auto info = entry->_proxies.getComponent<fep3::rpc::arya::IRPCParticipantInfo>(entry->_system, participant_name);
                 if (info)
                 {
                     try
                     {
-                        auto value = info->getRPCComponentInterfaceDefinition(object_name, intf_name);
+                        auto value = interface_definitions.get(intf_name,
+                            [&]()
+                            {
+                                return info->getRPCComponentInterfaceDefinition(object_name, intf_name);
+                            });
                         std::cout << value << std::endl;
                     }
                     catch (const std::exception& e)
                     {
+                        entry->_proxies.invalidate(participant_name);
                         std::cout << "participant \"" << participant_name << "@" << system_name << "\" IID info can not be retrieved " << std::endl;
                         return false;
                     }
@@ -1160,30 +2606,438 @@ namespace
         }
         catch (const std::exception& e)
         {
+            entry->_proxies.invalidate(participant_name);
             std::cout << "cannot get participant state for participant \"" + participant_name << "@" << system_name << "\", error: " << e.what() << std::endl;
             return false;
         }
         return true;
     }
 
+    static bool snapshotSystem(TokenIterator first, TokenIterator last)
+    {
+        const std::string system_name = *first;
+        const std::string file_name = *std::next(first);
+        size_t concurrency = 16u;
+        if (std::next(first, 2) != last && (!parseCount(*std::next(first, 2), concurrency) || concurrency == 0u))
+        {
+            std::cout << "invalid concurrency \"" << *std::next(first, 2) << "\"" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::ofstream snapshot_file(file_name, std::ios::binary);
+        if (!snapshot_file)
+        {
+            std::cout << "cannot open file \"" << file_name << "\" for writing" << std::endl;
+            return false;
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        const auto snapshot = system_snapshot::capture(entry->_name, entry->_system, entry->_proxies, interface_definitions, concurrency);
+        system_snapshot::write(snapshot_file, snapshot);
+        snapshot_file.close();
+
+        const auto failed = std::count_if(snapshot._participants.begin(), snapshot._participants.end(),
+            [](const system_snapshot::ParticipantInfo& participant) { return !participant._error.empty(); });
+        std::cout << "snapshot of \"" << entry->_name << "\" with " << snapshot._participants.size()
+            << " participants written to \"" << file_name << "\" in " << formatSeconds(std::chrono::steady_clock::now() - begin) << std::endl;
+        if (failed != 0 || !snapshot._error.empty() || !snapshot_file)
+        {
+            std::cout << "snapshot is incomplete, " << failed << " participants failed" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    static bool rpcCall(TokenIterator first, TokenIterator last)
+    {
+        const std::string system_name = *first;
+        const std::string participant_name = *std::next(first);
+        const std::string object_name = *std::next(first, 2);
+        const std::string iid = *std::next(first, 3);
+        const std::string method_name = *std::next(first, 4);
+        const std::string json_parameters = std::next(first, 5) != last ? *std::next(first, 5) : "[]";
+
+        const auto method = rpc_call::findMethod(iid, method_name);
+        if (!method)
+        {
+            std::cout << "no client for method \"" << method_name << "\" of \"" << iid << "\", supported methods:" << std::endl;
+            for (const auto& supported : rpc_call::getMethods())
+            {
+                std::cout << "    " << supported._object << " " << supported._iid << " " << supported._name << std::endl;
+            }
+            return false;
+        }
+        if (method->_object != object_name)
+        {
+            std::cout << "the client for \"" << iid << "\" only supports the RPC object \"" << method->_object << "\"" << std::endl;
+            return false;
+        }
+        std::vector<std::string> parameters;
+        std::string error;
+        if (!rpc_call::parseParameters(json_parameters, parameters, error))
+        {
+            std::cout << "invalid parameters, " << error << std::endl;
+            return false;
+        }
+        if (parameters.size() != method->_parameter_count)
+        {
+            std::cout << "\"" << method_name << "\" takes " << method->_parameter_count << " parameters ("
+                << parameters.size() << " given)" << std::endl;
+            return false;
+        }
+
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        if (!entry->_proxies.getParticipant(entry->_system, participant_name))
+        {
+            std::cout << "participant \"" << participant_name << "\" is not in system \"" << system_name << "\"" << std::endl;
+            return false;
+        }
+        std::string response;
+        const auto begin = std::chrono::steady_clock::now();
+        try
+        {
+            response = method->_call(entry->_proxies, entry->_system, participant_name, parameters);
+        }
+        catch (const std::exception& e)
+        {
+            entry->_proxies.invalidate(participant_name);
+            std::cout << "cannot call \"" << method_name << "\" of \"" << participant_name << "@" << system_name
+                << "\", error: " << e.what() << std::endl;
+            std::cout << "round trip time: " << formatMilliseconds(std::chrono::steady_clock::now() - begin) << std::endl;
+            return false;
+        }
+        const auto round_trip_time = std::chrono::steady_clock::now() - begin;
+        if (method_name == "shutdown")
+        {
+            entry->_proxies.invalidate(participant_name);
+        }
+        std::cout << response << std::endl;
+        std::cout << "round trip time: " << formatMilliseconds(round_trip_time) << std::endl;
+        return true;
+    }
+
+    static bool rpcBench(TokenIterator first, TokenIterator last)
+    {
+        //the participant name in the middle is optional: <system> [participant] <calls> <concurrency>
+        //the command table only knows trailing optional arguments, its count of 1 just allows 3 or 4 arguments
+        const std::string system_name = *first;
+        const bool all_participants = std::distance(first, last) == 3;
+        const std::string participant_name = all_participants ? "" : *std::next(first);
+        const std::string calls_argument = *std::prev(last, 2);
+        const std::string concurrency_argument = *std::prev(last);
+        size_t calls = 0u;
+        size_t concurrency = 0u;
+        if (!parseCount(calls_argument, calls) || calls == 0u)
+        {
+            std::cout << "invalid number of calls \"" << calls_argument << "\"" << std::endl;
+            return false;
+        }
+        if (!parseCount(concurrency_argument, concurrency) || concurrency == 0u)
+        {
+            std::cout << "invalid concurrency \"" << concurrency_argument << "\"" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        std::vector<std::string> participant_names;
+        if (all_participants)
+        {
+            for (const auto& participant : entry->_system.getParticipants())
+            {
+                participant_names.push_back(participant.getName());
+            }
+            std::sort(participant_names.begin(), participant_names.end());
+        }
+        else if (entry->_proxies.getParticipant(entry->_system, participant_name))
+        {
+            participant_names.push_back(participant_name);
+        }
+        else
+        {
+            std::cout << "participant \"" << participant_name << "\" is not in system \"" << system_name << "\"" << std::endl;
+            return false;
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        const auto results = rpc_bench::run(entry->_system, entry->_proxies, participant_names, calls, concurrency);
+        rpc_bench::print(std::cout, results, std::chrono::steady_clock::now() - begin);
+
+        bool success = true;
+        for (const auto& result : results)
+        {
+            if (!result._error.empty())
+            {
+                std::cout << "benchmark of participant \"" << result._name << "@" << system_name
+                    << "\" aborted, error: " << result._error << std::endl;
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    static bool timingMonitor(TokenIterator first, TokenIterator last)
+    {
+        const std::string system_name = *first;
+        size_t samples = 10u;
+        size_t interval = 1000u;
+        if (std::next(first) != last && (!parseCount(*std::next(first), samples) || samples == 0u))
+        {
+            std::cout << "invalid number of samples \"" << *std::next(first) << "\"" << std::endl;
+            return false;
+        }
+        if (std::distance(first, last) > 2 && !parseCount(*std::next(first, 2), interval))
+        {
+            std::cout << "invalid interval \"" << *std::next(first, 2) << "\"" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::unique_ptr<timing_monitor::Sampler> sampler;
+        std::string master_name;
+        {
+            std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+            std::vector<std::string> participant_names;
+            for (const auto& participant : entry->_system.getParticipants())
+            {
+                participant_names.push_back(participant.getName());
+            }
+            std::sort(participant_names.begin(), participant_names.end());
+            try
+            {
+                const auto masters = entry->_system.getCurrentTimingMasters();
+                if (masters.size() > 1u)
+                {
+                    std::cout << "more than one timing master (" << a_util::strings::join(masters, ",")
+                        << "), skew is measured against \"" << masters.front() << "\"" << std::endl;
+                }
+                if (!masters.empty())
+                {
+                    master_name = masters.front();
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::cout << "cannot get timing masters for \"" << system_name << "\" , error: " << e.what() << std::endl;
+                return false;
+            }
+            if (master_name.empty())
+            {
+                std::cout << "no timing master in system \"" << system_name << "\", only ratios are measured" << std::endl;
+            }
+            sampler.reset(new timing_monitor::Sampler(entry->_system, entry->_proxies, std::move(participant_names)));
+        }
+
+        // the operation lock is only held while sampling, so the system can be controlled in between
+        timing_monitor::TimingMonitor timing_monitor_state(master_name);
+        auto next_round = std::chrono::steady_clock::now();
+        for (size_t round = 0u; round < samples; ++round)
+        {
+            if (round != 0u)
+            {
+                next_round += std::chrono::milliseconds(interval);
+                std::this_thread::sleep_until(next_round);
+            }
+            std::vector<timing_monitor::Sample> round_samples;
+            {
+                std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+                round_samples = sampler->sample(property_concurrency);
+            }
+            timing_monitor_state.addRound(round_samples, std::cout);
+        }
+        timing_monitor_state.printSummary(std::cout);
+        return true;
+    }
+
+    static bool timingSweep(TokenIterator first, TokenIterator)
+    {
+        const std::string system_name = *first;
+        const std::string master_name = *std::next(first);
+        const auto step_sizes = a_util::strings::split(*std::next(first, 2), ",");
+        const auto factors = a_util::strings::split(*std::next(first, 3), ",");
+        size_t duration = 0u;
+        if (step_sizes.empty() || factors.empty())
+        {
+            std::cout << "use comma separated lists of step sizes and factors" << std::endl;
+            return false;
+        }
+        if (!parseCount(*std::next(first, 4), duration) || duration == 0u)
+        {
+            std::cout << "invalid duration \"" << *std::next(first, 4) << "\"" << std::endl;
+            return false;
+        }
+        auto entry = getConnectedOrDiscoveredSystem(system_name, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        if (!entry->_proxies.getParticipant(entry->_system, master_name))
+        {
+            std::cout << "participant \"" << master_name << "\" is not in system \"" << system_name << "\"" << std::endl;
+            return false;
+        }
+        try
+        {
+            entry->_system.setSystemState(fep3::SystemAggregatedState::loaded);
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "cannot set system \"" << system_name << "\" to loaded, error: " << e.what() << std::endl;
+            return false;
+        }
+
+        // every run replaces the timing configuration, the last one stays configured
+        entry->_applied_timing_properties.clear();
+        std::vector<timing_sweep::Result> results;
+        for (const auto& combination : timing_sweep::combine(step_sizes, factors))
+        {
+            results.push_back(timing_sweep::run(entry->_system, entry->_proxies, master_name, combination,
+                std::chrono::milliseconds(duration), property_concurrency));
+        }
+        timing_sweep::print(std::cout, results);
+
+        bool success = true;
+        for (const auto& result : results)
+        {
+            if (!result._error.empty())
+            {
+                std::cout << "step size " << result._combination._step_size << " with factor " << result._combination._factor
+                    << " failed, error: " << result._error << std::endl;
+                success = false;
+            }
+        }
+        return success;
+    }
+
+    static bool timingPreflight(TokenIterator first, TokenIterator)
+    {
+        auto entry = getConnectedOrDiscoveredSystem(*first, auto_discovery_of_systems);
+        if (!entry)
+        {
+            return false;
+        }
+        std::lock_guard<std::mutex> operation_lock(entry->_operation_mutex);
+        const auto begin = std::chrono::steady_clock::now();
+        if (!passesTimingPreflight(*entry, std::cout))
+        {
+            return false;
+        }
+        std::cout << "timing preflight of \"" << entry->_name << "\" passed in "
+            << formatMilliseconds(std::chrono::steady_clock::now() - begin) << std::endl;
+        return true;
+    }
+
+    static bool enableTimingPreflight(TokenIterator, TokenIterator)
+    {
+        timing_preflight_enabled = true;
+        std::cout << "timing preflight: enabled" << std::endl;
+        return true;
+    }
+
+    static bool disableTimingPreflight(TokenIterator, TokenIterator)
+    {
+        timing_preflight_enabled = false;
+        std::cout << "timing preflight: disabled" << std::endl;
+        return true;
+    }
+
+    /// "on" is the directory in the home directory of the user, "off" turns the cache off
+    static std::string getCacheDirectory(const std::string& argument, const std::string& name)
+    {
+        if (argument == "on")
+        {
+            return cache_files::getUserDirectory(name);
+        }
+        return argument == "off" ? "" : argument;
+    }
+
+    static bool propertyCache(TokenIterator first, TokenIterator last)
+    {
+        if (first != last)
+        {
+            compiled_properties.setDirectory(getCacheDirectory(*first, "compiled_properties"));
+        }
+        const auto directory = compiled_properties.getDirectory();
+        std::cout << "property cache: " << (directory.empty() ? "off" : "\"" + directory + "\"")
+            << ", " << compiled_properties.getHits() << " hits, " << compiled_properties.getMisses() << " misses" << std::endl;
+        return true;
+    }
+
+    static bool definitionCache(TokenIterator first, TokenIterator last)
+    {
+        if (first != last)
+        {
+            interface_definitions.setDirectory(getCacheDirectory(*first, "interface_definitions"));
+        }
+        const auto directory = interface_definitions.getDirectory();
+        std::cout << "definition cache: " << (directory.empty() ? "off" : "\"" + directory + "\"")
+            << ", " << interface_definitions.getHits() << " hits, " << interface_definitions.getMisses() << " misses" << std::endl;
+        return true;
+    }
+
+    static bool diffSnapshot(TokenIterator first, TokenIterator)
+    {
+        const std::string before_file_name = *first;
+        const std::string after_file_name = *std::next(first);
+        std::ifstream before_file(before_file_name, std::ios::binary);
+        if (!before_file)
+        {
+            std::cout << "cannot open file \"" << before_file_name << "\"" << std::endl;
+            return false;
+        }
+        std::ifstream after_file(after_file_name, std::ios::binary);
+        if (!after_file)
+        {
+            std::cout << "cannot open file \"" << after_file_name << "\"" << std::endl;
+            return false;
+        }
+        try
+        {
+            system_snapshot::diff(before_file, after_file, std::cout);
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << "cannot diff \"" << before_file_name << "\" and \"" << after_file_name << "\", error: " << e.what() << std::endl;
+            return false;
+        }
+        return true;
+    }
 
     std::vector<ControlCommand> Commands = {
-    { "exit", "quits this program", quit, {}, 0u },
-    { "quit", "quits this program", quit, {}, 0u },
+    { "exit", "quits this program", quit, {}, 0u, false },
+    { "quit", "quits this program", quit, {}, 0u, false },
     { "discoverAllSystems", "discovers all systems and registers logging monitor for them", discoverAllSystems, {}, 0u },
     { "discoverSystem", "discover one system with the given name and register the logging monitor for them", discoverSystem, { {"system name", noCompletion} }, 0u },
+    { "discoverSystems", "discovers all given systems within one discovery", discoverSystems, { {"system name", noCompletion} }, 0u, true, true },
     { "setCurrentWorkingDirectory", "changes the current working dir of this fep_control instance", setCurrentWorkingDirectory, { {"directory name", noCompletion} }, 0u },
     { "getCurrentWorkingDirectory", "prints the current working dir of this fep_control instance", getCurrentWorkingDirectory, {}, 0u },
     { "connectSystem", "connects the given system", connectSystem, { {"FEP SDK system descriptor (xml) file name", localFilesCompletion} }, 0u },
-    { "help", "prints out the description of the commands", help, { {"command name", commandNameCompletion } }, 1u },
-    { "loadSystem", "loads the given system", loadSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "unloadSystem", "unloads the given system", unloadSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "initializeSystem", "initializes the given system", initializeSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "deinitializeSystem", "deinitializes the given system", deinitializeSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "startSystem", "starts the given system", startSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "stopSystem", "stops the given system", stopSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "pauseSystem", "pauses the given system", pauseSystem, { {"system name", connectedSystemsCompletion} }, 0u },
-    { "shutdownSystem", "shutdown the given system", shutdownSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "help", "prints out the description of the commands", help, { {"command name", commandNameCompletion } }, 1u, false },
+    { "loadSystem", "loads the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", loadSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "unloadSystem", "unloads the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", unloadSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "initializeSystem", "initializes the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", initializeSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "deinitializeSystem", "deinitializes the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", deinitializeSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "startSystem", "starts the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", startSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "stopSystem", "stops the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", stopSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "pauseSystem", "pauses the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", pauseSystem, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "shutdownSystem", "shutdown the given system (or all systems matching a comma separated list of names and glob patterns concurrently)", shutdownSystem, { {"system name", connectedSystemsCompletion} }, 0u },
     { "startMonitoringSystem", "monitor logging messages of the given system", startMonitoringSystem, { {"system name", connectedSystemsCompletion} }, 0u },
     { "stopMonitoringSystem", "stop monitoring logging messages of the given system", stopMonitoringSystem, { {"system name", connectedSystemsCompletion} }, 0u },
     { "loadParticipant", "loads the given participant", loadParticipant, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}}, 0u },
@@ -1197,18 +3051,45 @@ namespace
     { "getParticipantRPCObjectIIDs", "retrieve the RPC IIDs of a concrete RPC Objects of the given participant", getRPCObjectIIDSParticipant, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}, {"object name", noCompletion}  }, 0u },
     { "getParticipantRPCObjectIIDDefinition", "retrieve the RPC Definition of an IID of a concrete RPC Objects of the given participant", getRPCObjectDefinitionParticipant, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}, {"object name", noCompletion}, {"interface id", noCompletion}  }, 0u },
     { "shutdownParticipant", "shutdown the given participant", shutdownParticipant, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion} }, 0u },
-    { "getSystemState", "retrieves the given system", getSystemState, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "getSystemState", "retrieves the given system state (or the states of all systems matching a comma separated list of names and glob patterns)", getSystemState, { {"system name", connectedSystemsCompletion} }, 0u },
     { "setSystemState", "sets the given system state", setSystemState, { {"system name", connectedSystemsCompletion}, {"system state", possibleSystemsStateCompletion} }, 0u },
     { "getParticipantState", "retrieves the given participants state", getParticipantState, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion} }, 0u },
     { "setParticipantState", "sets the given participants system state", setParticipantState, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion} , {"particiapnt state", possibleSystemsStateCompletion} }, 0u },
     { "getParticipants", "lists the participants of the given system", getParticipants, { {"system name", connectedSystemsCompletion} }, 0u},
-    { "configureSystem", "configures the given system", configureSystem, { {"system name", connectedSystemsCompletion}, {"FEP system properties file", localFilesCompletion} }, 0u },
+    { "configureSystem", "configures the given system, in mode delta only the properties whose current value differs from the file are set", configureSystem, { {"system name", connectedSystemsCompletion}, {"FEP system properties file", localFilesCompletion}, {"mode (full or delta)", configurationModeCompletion} }, 1u },
+    { "getProperties", "prints path, type and value of the properties matching the path pattern (wildcards * and ? per path segment) of the given participant or of all participants matching a glob pattern, queried in parallel", getProperties, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}, {"property path", noCompletion} }, 0u },
+    { "setProperties", "sets one or more properties given as <property path>=<value> on the given participant or on all participants matching a glob pattern, keeping the type of each property", setProperties, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}, {"property path=value", noCompletion} }, 0u, true, true },
+    { "saveConfiguration", "writes all properties of all participants of the given system, read in parallel, to a compact binary file, nothing is written if a participant cannot be read", saveConfiguration, { {"system name", connectedSystemsCompletion}, {"configuration file name", localFilesCompletion} }, 0u },
+    { "restoreConfiguration", "sets the properties saved by saveConfiguration again, only those whose current value differs", restoreConfiguration, { {"system name", connectedSystemsCompletion}, {"configuration file name", localFilesCompletion} }, 0u },
+    { "watchConfiguration", "applies the FEP system properties file in delta mode and then pushes the changed properties on every modification, once no further modification follows within the debounce time (default 100 ms)", watchConfiguration, { {"system name", connectedSystemsCompletion}, {"FEP system properties file", localFilesCompletion}, {"debounce time (in ms)", noCompletion} }, 1u },
+    { "stopWatchingConfiguration", "stops watching the FEP system properties file of the given system", stopWatchingConfiguration, { {"system name", connectedSystemsCompletion} }, 0u },
     { "configureTiming3SystemTime", "configures the given system for timing System Time (Sync only to the master)", configureSystemTimingSystemTime, { {"system name", connectedSystemsCompletion}, {"master participant name", connectedParticipantsCompletion} }, 0u },
-    { "configureTiming3DiscreteTime", "configures the given system for timing Discrete Time (for AFAP use 0.0 as factor)", configureSystemTimingDiscrete, { {"system name", connectedSystemsCompletion}, {"master participant name", connectedParticipantsCompletion}, {"factor", noCompletion} , {"step size (in ms)", noCompletion} }, 0u },
+    { "configureTiming3DiscreteTime", "configures the given system for timing Discrete Time (for AFAP use 0.0 as factor)", configureSystemTimingDiscrete, { {"system name", connectedSystemsCompletion}, {"master participant name", connectedParticipantsCompletion}, {"factor", noCompletion} , {"step size (in ns)", noCompletion} }, 0u },
     { "configureTiming3NoSync", "resets the timing configuration", configureSystemTimeNoSync, { {"system name", connectedSystemsCompletion} } , 0u },
     { "getCurrentTimingMaster", "retrieves the timing master from the systems participants", getCurrentTimingMaster, { {"system name", connectedSystemsCompletion} } , 0u },
+    { "snapshot", "writes participants, states, RPC objects, IIDs, interface definitions and timing masters of the given system to a file, querying up to <concurrency> (default 16) participants in parallel", snapshotSystem, { {"system name", connectedSystemsCompletion}, {"snapshot file name", localFilesCompletion}, {"concurrency", noCompletion} }, 1u },
+    { "rpcCall", "calls a method of an RPC object of the participant with parameters given as JSON array or object of strings and prints the JSON response and the round trip time", rpcCall, { {"system name", connectedSystemsCompletion}, {"participant name", connectedParticipantsCompletion}, {"RPC object name", noCompletion}, {"interface id", noCompletion}, {"method name", noCompletion}, {"JSON parameters", noCompletion} }, 1u },
+    { "rpcBench", "calls getRPCComponents <number of calls> times on the given participant, or on all participants (up to <concurrency> in parallel) if the participant name is omitted, and prints latency percentiles and calls per second per participant", rpcBench, { {"system name", connectedSystemsCompletion}, {"optional participant name", connectedParticipantsCompletion}, {"number of calls", noCompletion}, {"concurrency", noCompletion} }, 1u },
+    { "timingMonitor", "samples the main clock of every participant (default 10 times every 1000 ms) and prints the skew to the timing master, the achieved simulation time to wall time ratio and its jitter", timingMonitor, { {"system name", connectedSystemsCompletion}, {"number of samples", noCompletion}, {"interval in ms", noCompletion} }, 2u },
+    { "timingSweep", "sets the system to loaded and runs it for the given duration (in ms) with Discrete Time for every combination of the comma separated step sizes (in ns) and factors and prints the achieved throughput (simulated seconds per wall second) and the drift to the master", timingSweep, { {"system name", connectedSystemsCompletion}, {"master participant name", connectedParticipantsCompletion}, {"comma separated step sizes (in ns)", noCompletion}, {"comma separated factors", noCompletion}, {"duration (in ms)", noCompletion} }, 0u },
+    { "timingPreflight", "checks in parallel that all participants name the same timing master, that it exists and exposes clock_sync_master, and that step sizes and time factors are consistent", timingPreflight, { {"system name", connectedSystemsCompletion} }, 0u },
+    { "definitionCache", "prints the directory and hit counts of the interface definition cache, sets the directory, turns it on with \"on\" (in the home directory, off by default unless FEP_CONTROL_DEFINITION_CACHE is set) or off with \"off\"", definitionCache, { {"directory name", noCompletion} }, 1u },
+    { "propertyCache", "prints the directory and hit counts of the cache of compiled properties files, sets the directory, turns it on with \"on\" (in the home directory, off by default unless FEP_CONTROL_PROPERTY_CACHE is set) or off with \"off\"", propertyCache, { {"directory name", noCompletion} }, 1u },
+    { "diffSnapshot", "prints the differences between two snapshot files section by section", diffSnapshot, { {"snapshot file name", localFilesCompletion}, {"snapshot file name", localFilesCompletion} }, 0u },
+    { "transitionStats", "prints p50/p95/p99/max wall time of all state transitions done in this session and optionally exports them as CSV", transitionStats, { {"CSV file name", localFilesCompletion} }, 1u },
+    { "cycleSystem", "cycles the given system through the given transitions (default: load,initialize,start,stop,deinitialize,unload) and reports latencies, cycles/min and memory growth", cycleSystem, { {"system name", connectedSystemsCompletion}, {"number of cycles", noCompletion}, {"comma separated transitions", noCompletion}, {"JSON report file name", localFilesCompletion} }, 2u },
+    { "jobs", "lists the background jobs (command lines ending with &) with their state and elapsed time", listJobs, {}, 0u, false },
+    { "wait", "waits until the given background job (or all of them) is done", waitForJob, { {"job id", noCompletion} }, 1u, false },
+    { "cancel", "cancels the given background job if it is not yet running", cancelJob, { {"job id", noCompletion} }, 0u, false },
+    { "enableCanaryTransitions", "system transitions first transition the given number of participants, then all others with a worker pool", enableCanaryTransitions, { {"number of canary participants", noCompletion}, {"number of workers (default 8)", noCompletion} }, 1u },
+    { "disableCanaryTransitions", "system transitions are done by the FEP System library again", disableCanaryTransitions, {}, 0u },
+    { "enableTimingPreflight", "runs the timing preflight before startSystem, setSystemState and setParticipantState to running and cycleSystem with start (also staged) and refuses to start on problems, timingSweep configures the timing itself and is not checked", enableTimingPreflight, {}, 0u },
+    { "disableTimingPreflight", "systems are started without timing preflight again", disableTimingPreflight, {}, 0u },
     { "enableAutoDiscovery", "enable the auto discovery for commands on systems", enableAutoDiscovery, {}, 0u },
-    { "disableAutoDiscovery", "disable the auto discovery for commands on systems", disableAutoDiscovery, {}, 0u }
+    { "disableAutoDiscovery", "disable the auto discovery for commands on systems", disableAutoDiscovery, {}, 0u },
+    { "enableBackgroundDiscovery", "refreshes the discovered systems periodically in background (default every 5000 ms) and prints joined and left participants", enableBackgroundDiscovery, { {"interval in ms", noCompletion} }, 1u },
+    { "disableBackgroundDiscovery", "stops the periodic background discovery", disableBackgroundDiscovery, {}, 0u },
+    { "waitForParticipantChanges", "prints the joined and left participants the background discovery found since the last call, waits for the next ones if there are none (default timeout 10000 ms)", waitForParticipantChanges, { {"timeout in ms", noCompletion} }, 1u }
     };
 
     static inline std::vector<ControlCommand>::const_iterator findCommand(const std::string& command_candidate)
@@ -1253,13 +3134,17 @@ namespace
             {
                 std::cout << " <" << argument._description << '>';
             }
+            if (it->_variadic)
+            {
+                std::cout << " ...";
+            }
             std::cout << " : " << it->_description << std::endl;
         }
         return true;
     }
 }
 
-static int processCommandline(const std::vector<std::string>& command_line)
+static int validateCommandline(const std::vector<std::string>& command_line, std::vector<ControlCommand>::const_iterator& command)
 {
     assert(!command_line.empty());
     auto it = findCommand(command_line[0]);
@@ -1268,10 +3153,15 @@ static int processCommandline(const std::vector<std::string>& command_line)
         std::cout << "Invalid command \"" << command_line[0] << "\", use \"help\" for valid commands" << std::endl;
         return -2;
     }
-    if (command_line.size() > (*it)._arguments.size() + 1u || command_line.size() < (*it)._arguments.size() + 1u - (*it)._last_optional_parameters)
+    if ((command_line.size() > (*it)._arguments.size() + 1u && !(*it)._variadic)
+        || command_line.size() < (*it)._arguments.size() + 1u - (*it)._last_optional_parameters)
     {
         std::cout << "Invalid number of arguments for \"" << command_line[0] << "\" (" << command_line.size() - 1u << " instead of ";
-        if ((*it)._last_optional_parameters == 0u)
+        if ((*it)._variadic)
+        {
+            std::cout << (*it)._arguments.size() - (*it)._last_optional_parameters << " or more";
+        }
+        else if ((*it)._last_optional_parameters == 0u)
         {
             std::cout << (*it)._arguments.size();
         }
@@ -1282,9 +3172,63 @@ static int processCommandline(const std::vector<std::string>& command_line)
         std::cout << "), use \"help\" for more information" << std::endl;
         return -3;
     }
+    command = it;
+    return 0;
+}
+
+static int processCommandline(const std::vector<std::string>& command_line)
+{
+    std::vector<ControlCommand>::const_iterator it;
+    const int result = validateCommandline(command_line, it);
+    if (result != 0)
+    {
+        return result;
+    }
     return (*it)._action(command_line.begin() + 1, command_line.end()) ? 0 : 1;
 }
 
+static int processCommandlineInBackground(const std::vector<std::string>& command_line)
+{
+    std::vector<ControlCommand>::const_iterator it;
+    const int result = validateCommandline(command_line, it);
+    if (result != 0)
+    {
+        return result;
+    }
+    if (!(*it)._allowed_in_background)
+    {
+        std::cout << "\"" << command_line[0] << "\" cannot run in background" << std::endl;
+        return -4;
+    }
+    //jobs on the same system (the first argument) keep their order, the operation lock alone would not
+    const std::string key = command_line.size() > 1u ? command_line[1] : std::string();
+    const auto id = background_jobs.submit(a_util::strings::join(command_line, " "), key,
+        [it, command_line]()
+        {
+            //systems are locked per operation, see system_registry::SystemEntry
+            console_output::Capture capture;
+            return (*it)._action(command_line.begin() + 1, command_line.end()) ? 0 : 1;
+        });
+    std::cout << "[" << id << "] " << a_util::strings::join(command_line, " ") << std::endl;
+    return 0;
+}
+
+/// removes a trailing "&" (separate or attached to the last word) and returns whether there was one
+static bool removeBackgroundMarker(std::vector<std::string>& line_tokens)
+{
+    auto& last_token = line_tokens.back();
+    if (last_token.size() < 1u || last_token.back() != '&')
+    {
+        return false;
+    }
+    last_token.pop_back();
+    if (last_token.empty())
+    {
+        line_tokens.pop_back();
+    }
+    return true;
+}
+
 static std::vector<std::string> commandCompletion(const std::string& input)
 {
     std::vector<std::string> input_tokens = parseLine(input);
@@ -1305,6 +3249,10 @@ static std::vector<std::string> commandCompletion(const std::string& input)
         if (it != Commands.end())
         {
             size_t index_in_args = input_tokens.size() - 2u;
+            if ((*it)._variadic && !(*it)._arguments.empty())
+            {
+                index_in_args = std::min(index_in_args, (*it)._arguments.size() - 1u);
+            }
             if (index_in_args < (*it)._arguments.size())
             {
                 auto completion_list = (*it)._arguments[index_in_args]._completion(input_tokens.back());
@@ -1330,14 +3278,29 @@ static void interactiveLoop()
     line_noise::setCallback(commandCompletion);
 
     std::string line;
-    while (line_noise::readLine(line))
+    while (!quit_requested)
     {
+        console_output::setPrompt(line_noise::prompt);
+        const bool has_line = line_noise::readLine(line);
+        console_output::setPrompt("");
+        if (!has_line)
+        {
+            break;
+        }
         auto lineTokens = parseLine(line);
         if (lineTokens.empty())
         {
             continue;
         }
         line_noise::addToHistory(line);
+        if (removeBackgroundMarker(lineTokens))
+        {
+            if (!lineTokens.empty())
+            {
+                processCommandlineInBackground(lineTokens);
+            }
+            continue;
+        }
         processCommandline(lineTokens);
     }
 }
@@ -1376,6 +3339,7 @@ int parseAndExecuteCommandline(int argc, char *argv[])
 
 int main(int argc, char *argv[])
 {
+    console_output::install();
     if (argc > 1)
     {
         return parseAndExecuteCommandline(argc - 1, argv + 1); // shift by one
@@ -1383,6 +3347,13 @@ int main(int argc, char *argv[])
 	printWelcomeMessage();
     interactiveLoop();
 
+    //background jobs and the discovery may still use the systems
+    background_jobs.waitAll();
+    system_discoverer.stop();
+    {
+        std::lock_guard<std::mutex> lock(configuration_watchers_mutex);
+        configuration_watchers.clear();
+    }
     //we clear that here before any static variable ist closed 
     connected_or_discovered_systems.clear();
 
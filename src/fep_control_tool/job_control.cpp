@@ -0,0 +1,217 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+#include "job_control.h"
+
+#include <algorithm>
+
+std::string job_control::toString(JobState state)
+{
+    switch (state)
+    {
+        case JobState::queued: return "queued";
+        case JobState::running: return "running";
+        case JobState::finished: return "finished";
+        case JobState::failed: return "failed";
+        case JobState::cancelled: return "cancelled";
+        default: break;
+    }
+    return "unknown";
+}
+
+job_control::JobExecutor::JobExecutor(CompletionCallback on_completion, size_t worker_count)
+    : _on_completion(std::move(on_completion)), _worker_count(std::max<size_t>(worker_count, 1u))
+{
+}
+
+job_control::JobExecutor::~JobExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+        for (const auto id : _queue)
+        {
+            _jobs[id]._state = JobState::cancelled;
+        }
+        _queue.clear();
+    }
+    _job_queued.notify_all();
+    _job_done.notify_all();
+    for (auto& worker : _workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t job_control::JobExecutor::submit(const std::string& command_line, const std::string& key, Task task)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint32_t id = _next_id++;
+    Job job;
+    job._command_line = command_line;
+    job._key = key;
+    job._task = std::move(task);
+    job._state = JobState::queued;
+    job._submitted = std::chrono::steady_clock::now();
+    _jobs.emplace(id, std::move(job));
+    _queue.push_back(id);
+    //a worker is started for every queued job until there are enough of them
+    if (_workers.size() < _worker_count)
+    {
+        _workers.emplace_back(&JobExecutor::run, this);
+    }
+    _job_queued.notify_all();
+    return id;
+}
+
+std::deque<uint32_t>::iterator job_control::JobExecutor::findRunnable()
+{
+    //a later job with a running key is never taken before an earlier one, that keeps the order per key
+    return std::find_if(_queue.begin(), _queue.end(), [this](uint32_t id)
+    {
+        return _running_keys.count(_jobs[id]._key) == 0u;
+    });
+}
+
+void job_control::JobExecutor::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;)
+    {
+        _job_queued.wait(lock, [this]() { return _stop || findRunnable() != _queue.end(); });
+        if (_stop)
+        {
+            return;
+        }
+        const auto runnable = findRunnable();
+        const uint32_t id = *runnable;
+        _queue.erase(runnable);
+        auto& job = _jobs[id];
+        const auto running_key = _running_keys.insert(job._key);
+        job._state = JobState::running;
+        job._started = std::chrono::steady_clock::now();
+        Task task = std::move(job._task);
+
+        lock.unlock();
+        int result = -1;
+        try
+        {
+            result = task();
+        }
+        catch (...)
+        {
+        }
+        lock.lock();
+
+        // the job is reported before it counts as done, so waiters see its output first
+        job._done = std::chrono::steady_clock::now();
+        const JobState final_state = result == 0 ? JobState::finished : JobState::failed;
+        const JobInfo info{ id, job._command_line, final_state, job._done - job._started };
+
+        lock.unlock();
+        if (_on_completion)
+        {
+            _on_completion(info);
+        }
+        lock.lock();
+
+        job._state = final_state;
+        _running_keys.erase(running_key);
+        _job_done.notify_all();
+        _job_queued.notify_all();
+    }
+}
+
+job_control::JobInfo job_control::JobExecutor::getInfo(uint32_t id, const Job& job) const
+{
+    const auto now = std::chrono::steady_clock::now();
+    JobInfo info{ id, job._command_line, job._state, std::chrono::steady_clock::duration::zero() };
+    switch (job._state)
+    {
+        case JobState::queued: info._elapsed = now - job._submitted; break;
+        case JobState::running: info._elapsed = now - job._started; break;
+        case JobState::finished:
+        case JobState::failed: info._elapsed = job._done - job._started; break;
+        default: break;
+    }
+    return info;
+}
+
+std::vector<job_control::JobInfo> job_control::JobExecutor::list() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<JobInfo> infos;
+    for (const auto& job : _jobs)
+    {
+        infos.push_back(getInfo(job.first, job.second));
+    }
+    return infos;
+}
+
+bool job_control::JobExecutor::wait(uint32_t id, JobInfo& info)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _jobs.find(id);
+    if (it == _jobs.end())
+    {
+        return false;
+    }
+    _job_done.wait(lock, [&]()
+    {
+        return _stop || (it->second._state != JobState::queued && it->second._state != JobState::running);
+    });
+    info = getInfo(id, it->second);
+    return true;
+}
+
+void job_control::JobExecutor::waitAll()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    const uint32_t last_id = _next_id - 1u;
+    _job_done.wait(lock, [&]()
+    {
+        return _stop || std::none_of(_jobs.begin(), _jobs.end(), [last_id](const std::pair<const uint32_t, Job>& job)
+        {
+            return job.first <= last_id && (job.second._state == JobState::queued || job.second._state == JobState::running);
+        });
+    });
+}
+
+job_control::CancelResult job_control::JobExecutor::cancel(uint32_t id)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _jobs.find(id);
+    if (it == _jobs.end())
+    {
+        return CancelResult::unknown;
+    }
+    switch (it->second._state)
+    {
+        case JobState::queued:
+            _queue.erase(std::remove(_queue.begin(), _queue.end(), id), _queue.end());
+            it->second._state = JobState::cancelled;
+            it->second._task = nullptr;
+            _job_done.notify_all();
+            return CancelResult::cancelled;
+        case JobState::running:
+            return CancelResult::running;
+        default:
+            return CancelResult::done;
+    }
+}
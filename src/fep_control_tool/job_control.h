@@ -0,0 +1,115 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace job_control
+{
+    enum class JobState
+    {
+        queued,
+        running,
+        finished,
+        failed,
+        cancelled
+    };
+
+    std::string toString(JobState state);
+
+    struct JobInfo
+    {
+        uint32_t _id;
+        std::string _command_line;
+        JobState _state;
+        /// time waited while queued, time running so far or total run time when done
+        std::chrono::steady_clock::duration _elapsed;
+    };
+
+    enum class CancelResult
+    {
+        cancelled,
+        running,
+        done,
+        unknown
+    };
+
+    /**
+     * Executes submitted jobs on up to @p worker_count background threads.
+     * Jobs with the same key run one after another in submission order, jobs with different keys in parallel.
+     * A job returning a non zero value is reported as failed.
+     * Queued jobs can be cancelled, running jobs can only be waited for.
+     */
+    class JobExecutor
+    {
+    public:
+        typedef std::function<int()> Task;
+        typedef std::function<void(const JobInfo&)> CompletionCallback;
+
+        JobExecutor(CompletionCallback on_completion, size_t worker_count);
+        ~JobExecutor();
+
+        uint32_t submit(const std::string& command_line, const std::string& key, Task task);
+        std::vector<JobInfo> list() const;
+        /// blocks until the job is done, returns false if there is no such job
+        bool wait(uint32_t id, JobInfo& info);
+        /// blocks until all jobs submitted so far are done
+        void waitAll();
+        CancelResult cancel(uint32_t id);
+
+    private:
+        struct Job
+        {
+            std::string _command_line;
+            std::string _key;
+            Task _task;
+            JobState _state;
+            std::chrono::steady_clock::time_point _submitted;
+            std::chrono::steady_clock::time_point _started;
+            std::chrono::steady_clock::time_point _done;
+        };
+
+        void run();
+        /// returns the position of the first queued job whose key is not running, or the end of the queue
+        std::deque<uint32_t>::iterator findRunnable();
+        JobInfo getInfo(uint32_t id, const Job& job) const;
+
+        CompletionCallback _on_completion;
+        mutable std::mutex _mutex;
+        std::condition_variable _job_queued;
+        std::condition_variable _job_done;
+        std::map<uint32_t, Job> _jobs;
+        std::deque<uint32_t> _queue;
+        std::multiset<std::string> _running_keys;
+        uint32_t _next_id = 1u;
+        bool _stop = false;
+        const size_t _worker_count;
+        std::vector<std::thread> _workers;
+    };
+}
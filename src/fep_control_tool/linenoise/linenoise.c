@@ -185,6 +185,12 @@ struct current {
 static int fd_read(struct current *current);
 static int getWindowSize(struct current *current);
 
+/* The line being edited and the lock that is released while waiting for a key,
+ * so other threads can print and repaint the line with linenoiseRefreshEditedLine() */
+static struct current *edited_line = NULL;
+static linenoiseLockFunction *edit_lock = NULL;
+static linenoiseLockFunction *edit_unlock = NULL;
+
 void linenoiseHistoryFree(void) {
     if (history) {
         int j;
@@ -806,6 +812,16 @@ static int get_char(struct current *current, int pos)
     return -1;
 }
 
+static int read_key(struct current *current)
+{
+    int c;
+
+    if (edit_unlock) edit_unlock();
+    c = fd_read(current);
+    if (edit_lock) edit_lock();
+    return c;
+}
+
 static void refreshLine(const char *prompt, struct current *current)
 {
     int plen;
@@ -1095,7 +1111,7 @@ static int completeLine(struct current *current) {
                 refreshLine(current->prompt, current);
             }
 
-            c = fd_read(current);
+            c = read_key(current);
             if (c == -1) {
                 break;
             }
@@ -1143,7 +1159,20 @@ void linenoiseAddCompletion(linenoiseCompletions *lc, const char *str) {
 
 #endif
 
+static int linenoiseEditLocked(struct current *current);
+
 static int linenoiseEdit(struct current *current) {
+    int count;
+
+    if (edit_lock) edit_lock();
+    edited_line = current;
+    count = linenoiseEditLocked(current);
+    edited_line = NULL;
+    if (edit_unlock) edit_unlock();
+    return count;
+}
+
+static int linenoiseEditLocked(struct current *current) {
     int history_index = 0;
 
     /* The latest history entry is always our current buffer, that
@@ -1155,7 +1184,7 @@ static int linenoiseEdit(struct current *current) {
 
     while(1) {
         int dir = -1;
-        int c = fd_read(current);
+        int c = read_key(current);
 
 #ifndef NO_COMPLETION
         /* Only autocomplete when the callback is set. It returns < 0 when
@@ -1245,7 +1274,7 @@ process_char:
 
                     snprintf(rprompt, sizeof(rprompt), "(reverse-i-search)'%s': ", rbuf);
                     refreshLine(rprompt, current);
-                    c = fd_read(current);
+                    c = read_key(current);
                     if (c == ctrl('H') || c == 127) {
                         if (rchars) {
                             int p = utf8_index(rbuf, --rchars);
@@ -1344,7 +1373,7 @@ process_char:
                 if (insert_char(current, current->pos, c)) {
                     refreshLine(current->prompt, current);
                     /* Now wait for the next char. Can insert anything except \0 */
-                    c = fd_read(current);
+                    c = read_key(current);
 
                     /* Remove the ^V first */
                     remove_char(current, current->pos - 1);
@@ -1445,6 +1474,26 @@ history_navigation:
     return current->len;
 }
 
+void linenoiseSetEditLock(linenoiseLockFunction *lock, linenoiseLockFunction *unlock)
+{
+    edit_lock = lock;
+    edit_unlock = unlock;
+}
+
+int linenoiseIsEditing(void)
+{
+    return edited_line != NULL;
+}
+
+int linenoiseRefreshEditedLine(void)
+{
+    if (edited_line == NULL) {
+        return 0;
+    }
+    refreshLine(edited_line->prompt, edited_line);
+    return 1;
+}
+
 int linenoiseColumns(void)
 {
     struct current current;
@@ -117,4 +117,22 @@ char **linenoiseHistory(int *len);
  */
 int linenoiseColumns(void);
 
+typedef void(linenoiseLockFunction)(void);
+
+/*
+ * Sets the lock that is held while a line is edited, except while waiting for a key.
+ */
+void linenoiseSetEditLock(linenoiseLockFunction *lock, linenoiseLockFunction *unlock);
+
+/*
+ * Returns 1 while a line is edited in raw mode, the caller holds the edit lock.
+ */
+int linenoiseIsEditing(void);
+
+/*
+ * Repaints the prompt and the line being edited after other output, the caller holds the edit lock.
+ * Returns 0 if no line is edited in raw mode.
+ */
+int linenoiseRefreshEditedLine(void);
+
 #endif /* __LINENOISE_H */
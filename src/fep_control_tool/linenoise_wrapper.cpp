@@ -27,7 +27,7 @@ extern "C"
 
 bool line_noise::readLine(std::string& line)
 {
-    char *strLine = linenoise("fep> ");
+    char *strLine = linenoise(prompt);
     if (strLine == nullptr)
     {
         return false;
@@ -69,3 +69,18 @@ void line_noise::addToHistory(const std::string& line)
 {
     linenoiseHistoryAdd(line.c_str());
 }
+
+void line_noise::setEditLock(LockFunction* lock, LockFunction* unlock)
+{
+    linenoiseSetEditLock(lock, unlock);
+}
+
+bool line_noise::isEditing()
+{
+    return linenoiseIsEditing() != 0;
+}
+
+void line_noise::refreshLine()
+{
+    linenoiseRefreshEditedLine();
+}
@@ -24,9 +24,20 @@
 
 namespace line_noise
 {
+    /// shown by readLine while it waits for input
+    constexpr const char* prompt = "fep> ";
+
     bool readLine(std::string& line);
 
     typedef std::function<std::vector<std::string>(const std::string& input)> CallBackFunction;
     void setCallback(CallBackFunction callback_function);
     void addToHistory(const std::string& line);
+
+    typedef void(LockFunction)();
+    /// @p lock is held by readLine while it edits the line, except while it waits for a key
+    void setEditLock(LockFunction* lock, LockFunction* unlock);
+    /// whether readLine edits a line on a terminal, the caller holds the edit lock
+    bool isEditing();
+    /// repaints the prompt and the typed text of the edited line, the caller holds the edit lock
+    void refreshLine();
 }
\ No newline at end of file
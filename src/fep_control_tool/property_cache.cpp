@@ -0,0 +1,331 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "property_cache.h"
+
+#include <cstring>
+
+#include <sys/stat.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "cache_files.h"
+#include "content_hash.h"
+#include "control_tool_common_helper.h"
+
+namespace
+{
+    const char magic[] = { 'F', 'E', 'P', 'P', 'R', 'O', 'P', 'C' };
+    const uint32_t format_version = 1u;
+
+    class Writer
+    {
+    public:
+        template <typename Integer>
+        void write(Integer value)
+        {
+            _out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void write(const std::string& value)
+        {
+            write(static_cast<uint32_t>(value.size()));
+            _out.append(value);
+        }
+
+        void write(const std::vector<system_properties::Property>& properties)
+        {
+            write(static_cast<uint32_t>(properties.size()));
+            for (const auto& property : properties)
+            {
+                write(property._path);
+                write(property._type);
+                write(property._value);
+            }
+        }
+
+        std::string& get()
+        {
+            return _out;
+        }
+
+    private:
+        std::string _out;
+    };
+
+    /// bounds checked reader over the mapped data
+    class Reader
+    {
+    public:
+        Reader(const char* data, size_t size) : _data(data), _end(data + size)
+        {
+        }
+
+        template <typename Integer>
+        bool read(Integer& value)
+        {
+            if (static_cast<size_t>(_end - _data) < sizeof(value))
+            {
+                return false;
+            }
+            std::memcpy(&value, _data, sizeof(value));
+            _data += sizeof(value);
+            return true;
+        }
+
+        bool read(std::string& value)
+        {
+            uint32_t size = 0u;
+            if (!read(size) || static_cast<size_t>(_end - _data) < size)
+            {
+                return false;
+            }
+            value.assign(_data, size);
+            _data += size;
+            return true;
+        }
+
+        bool read(std::vector<system_properties::Property>& properties)
+        {
+            uint32_t count = 0u;
+            //every property takes at least its three lengths, so damaged counts cannot allocate much
+            if (!read(count) || count > static_cast<size_t>(_end - _data) / (3u * sizeof(uint32_t)))
+            {
+                return false;
+            }
+            properties.resize(count);
+            for (auto& property : properties)
+            {
+                if (!read(property._path) || !read(property._type) || !read(property._value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool readMagic()
+        {
+            if (static_cast<size_t>(_end - _data) < sizeof(magic) || std::memcmp(_data, magic, sizeof(magic)) != 0)
+            {
+                return false;
+            }
+            _data += sizeof(magic);
+            return true;
+        }
+
+        bool atEnd() const
+        {
+            return _data == _end;
+        }
+
+    private:
+        const char* _data;
+        const char* _end;
+    };
+}
+
+property_cache::MappedFile::MappedFile(const std::string& file_name)
+{
+#ifdef WIN32
+    _file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_file == INVALID_HANDLE_VALUE)
+    {
+        _file = nullptr;
+        return;
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size) || size.QuadPart == 0)
+    {
+        return;
+    }
+    _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_mapping == nullptr)
+    {
+        return;
+    }
+    _data = static_cast<const char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    _size = _data == nullptr ? 0u : static_cast<size_t>(size.QuadPart);
+#else
+    const int file = ::open(file_name.c_str(), O_RDONLY);
+    if (file < 0)
+    {
+        return;
+    }
+    struct stat info;
+    if (::fstat(file, &info) == 0 && info.st_size > 0)
+    {
+        void* data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            _data = static_cast<const char*>(data);
+            _size = static_cast<size_t>(info.st_size);
+        }
+    }
+    //the mapping stays valid after closing the descriptor
+    ::close(file);
+#endif
+}
+
+property_cache::MappedFile::~MappedFile()
+{
+#ifdef WIN32
+    if (_data != nullptr)
+    {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping != nullptr)
+    {
+        CloseHandle(_mapping);
+    }
+    if (_file != nullptr)
+    {
+        CloseHandle(_file);
+    }
+#else
+    if (_data != nullptr)
+    {
+        ::munmap(const_cast<char*>(_data), _size);
+    }
+#endif
+}
+
+const char* property_cache::MappedFile::getData() const
+{
+    return _data;
+}
+
+size_t property_cache::MappedFile::getSize() const
+{
+    return _size;
+}
+
+std::string property_cache::compile(const SourceKey& key, const system_properties::PropertyFile& file)
+{
+    Writer writer;
+    writer.get().append(magic, sizeof(magic));
+    writer.write(format_version);
+    writer.write(key._mtime);
+    writer.write(key._size);
+    writer.write(key._hash);
+    writer.write(file._system_properties);
+    writer.write(static_cast<uint32_t>(file._element_properties.size()));
+    for (const auto& element : file._element_properties)
+    {
+        writer.write(element.first);
+        writer.write(element.second);
+    }
+    writer.write(file._timing_properties);
+    return std::move(writer.get());
+}
+
+bool property_cache::decompile(const char* data, size_t size, SourceKey& key, system_properties::PropertyFile& file)
+{
+    Reader reader(data, size);
+    uint32_t version = 0u;
+    if (!reader.readMagic() || !reader.read(version) || version != format_version
+        || !reader.read(key._mtime) || !reader.read(key._size) || !reader.read(key._hash)
+        || !reader.read(file._system_properties))
+    {
+        return false;
+    }
+    uint32_t element_count = 0u;
+    if (!reader.read(element_count))
+    {
+        return false;
+    }
+    file._element_properties.clear();
+    for (uint32_t index = 0u; index < element_count; ++index)
+    {
+        std::string participant_name;
+        if (!reader.read(participant_name) || !reader.read(file._element_properties[participant_name]))
+        {
+            return false;
+        }
+    }
+    return reader.read(file._timing_properties) && reader.atEnd();
+}
+
+property_cache::PropertyCache::PropertyCache(const std::string& directory)
+    : _directory(directory), _hits(0u), _misses(0u)
+{
+}
+
+void property_cache::PropertyCache::setDirectory(const std::string& directory)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _directory = directory;
+}
+
+std::string property_cache::PropertyCache::getDirectory() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _directory;
+}
+
+system_properties::PropertyFile property_cache::PropertyCache::load(const std::string& file_name)
+{
+    const auto directory = getDirectory();
+    std::string content;
+    if (directory.empty() || !cache_files::readFile(file_name, content))
+    {
+        ++_misses;
+        return system_properties::load(file_name);
+    }
+    //modification times are too coarse to notice two saves within one tick, hashing is still far cheaper than parsing
+    SourceKey source;
+    source._size = content.size();
+    source._hash = content_hash::hash(content);
+    const auto compiled_file_name = directory + "/" + content_hash::toHex(content_hash::hash(getAbsolutePath(file_name)));
+
+    SourceKey cached;
+    system_properties::PropertyFile file;
+    bool compiled = false;
+    {
+        const MappedFile mapped(compiled_file_name);
+        compiled = mapped.getData() != nullptr && decompile(mapped.getData(), mapped.getSize(), cached, file);
+    }
+    if (compiled && cached._hash == source._hash && cached._size == source._size)
+    {
+        ++_hits;
+        return file;
+    }
+    ++_misses;
+    file = system_properties::load(file_name);
+    cache_files::createDirectories(directory);
+    cache_files::writeFileAtomically(compiled_file_name, compile(source, file));
+    return file;
+}
+
+uint64_t property_cache::PropertyCache::getHits() const
+{
+    return _hits;
+}
+
+uint64_t property_cache::PropertyCache::getMisses() const
+{
+    return _misses;
+}
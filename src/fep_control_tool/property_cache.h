@@ -0,0 +1,95 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "system_properties.h"
+
+namespace property_cache
+{
+    /// identifies the content of a source file
+    struct SourceKey
+    {
+        /// not compared any more (too coarse), kept so compiled files keep their format
+        int64_t _mtime = 0;
+        uint64_t _size = 0u;
+        uint64_t _hash = 0u;
+    };
+
+    /// read only memory mapping of a whole file, empty if the file cannot be mapped
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string& file_name);
+        ~MappedFile();
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* getData() const;
+        size_t getSize() const;
+
+    private:
+        const char* _data = nullptr;
+        size_t _size = 0u;
+#ifdef WIN32
+        void* _file = nullptr;
+        void* _mapping = nullptr;
+#endif
+    };
+
+    /**
+     * Compiled format: the magic "FEPPROPC", a version, the SourceKey and the three sections as counts
+     * and length prefixed strings, all integers in host byte order. It is read straight from a mapping.
+     */
+    std::string compile(const SourceKey& key, const system_properties::PropertyFile& file);
+    /// returns false if @p data is not a complete compiled file of this version
+    bool decompile(const char* data, size_t size, SourceKey& key, system_properties::PropertyFile& file);
+
+    /**
+     * Disk cache of parsed properties files, one compiled file per source path.
+     * The source is read and hashed on every load and only parsed again if its content changed.
+     * Compiled files are written with cache_files::writeFileAtomically. All methods are thread safe.
+     */
+    class PropertyCache
+    {
+    public:
+        explicit PropertyCache(const std::string& directory);
+
+        /// an empty directory disables the cache
+        void setDirectory(const std::string& directory);
+        std::string getDirectory() const;
+
+        /// throws std::runtime_error like system_properties::load if the source cannot be parsed
+        system_properties::PropertyFile load(const std::string& file_name);
+
+        uint64_t getHits() const;
+        uint64_t getMisses() const;
+
+    private:
+        mutable std::mutex _mutex;
+        std::string _directory;
+        std::atomic<uint64_t> _hits;
+        std::atomic<uint64_t> _misses;
+    };
+}
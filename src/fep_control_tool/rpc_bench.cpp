@@ -0,0 +1,127 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "rpc_bench.h"
+
+#include <iomanip>
+#include <sstream>
+
+#include "worker_pool.h"
+
+namespace
+{
+    std::string toMilliseconds(std::chrono::microseconds value)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << value.count() / 1000.0;
+        return out.str();
+    }
+
+    std::string toCallsPerSecond(uint64_t calls, std::chrono::steady_clock::duration duration)
+    {
+        const double seconds = std::chrono::duration<double>(duration).count();
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << (seconds > 0.0 ? calls / seconds : 0.0);
+        return out.str();
+    }
+
+    void benchParticipant(fep3::System& system,
+                          rpc_proxy_cache::ProxyCache& proxies,
+                          size_t calls,
+                          rpc_bench::ParticipantResult& result)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        try
+        {
+            auto info = proxies.getComponent<fep3::rpc::arya::IRPCParticipantInfo>(system, result._name);
+            if (!info)
+            {
+                result._error = "participant has no RPC Info";
+                return;
+            }
+            for (size_t call = 0u; call < calls; ++call)
+            {
+                const auto call_begin = std::chrono::steady_clock::now();
+                try
+                {
+                    info->getRPCComponents();
+                }
+                catch (...)
+                {
+                    result._latencies.recordFailure();
+                    throw;
+                }
+                result._latencies.record(std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - call_begin));
+            }
+        }
+        catch (const std::exception& e)
+        {
+            result._error = e.what();
+            proxies.invalidate(result._name);
+        }
+        result._duration = std::chrono::steady_clock::now() - begin;
+    }
+}
+
+std::vector<rpc_bench::ParticipantResult> rpc_bench::run(fep3::System& system,
+                                                         rpc_proxy_cache::ProxyCache& proxies,
+                                                         const std::vector<std::string>& participant_names,
+                                                         size_t calls,
+                                                         size_t concurrency)
+{
+    std::vector<ParticipantResult> results(participant_names.size());
+    for (size_t index = 0u; index < participant_names.size(); ++index)
+    {
+        results[index]._name = participant_names[index];
+    }
+    worker_pool::parallelFor(results.size(), concurrency,
+        [&](size_t index)
+        {
+            benchParticipant(system, proxies, calls, results[index]);
+        });
+    return results;
+}
+
+void rpc_bench::print(std::ostream& out,
+                      const std::vector<ParticipantResult>& results,
+                      std::chrono::steady_clock::duration total_duration)
+{
+    out << "participant count failed p50[ms] p95[ms] p99[ms] max[ms] calls/s" << std::endl;
+    uint64_t total_count = 0u;
+    uint64_t total_failed = 0u;
+    for (const auto& result : results)
+    {
+        const auto& histogram = result._latencies;
+        out << result._name << " "
+            << histogram.getCount() << " "
+            << histogram.getFailedCount() << " "
+            << toMilliseconds(histogram.getPercentile(50.0)) << " "
+            << toMilliseconds(histogram.getPercentile(95.0)) << " "
+            << toMilliseconds(histogram.getPercentile(99.0)) << " "
+            << toMilliseconds(histogram.getMax()) << " "
+            << toCallsPerSecond(histogram.getCount(), result._duration) << std::endl;
+        total_count += histogram.getCount();
+        total_failed += histogram.getFailedCount();
+    }
+    out << "total " << total_count << " calls, " << total_failed << " failed in "
+        << toMilliseconds(std::chrono::duration_cast<std::chrono::microseconds>(total_duration)) << " ms, "
+        << toCallsPerSecond(total_count, total_duration) << " calls/s" << std::endl;
+}
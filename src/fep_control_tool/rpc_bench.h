@@ -0,0 +1,59 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+#include "transition_statistics.h"
+
+namespace rpc_bench
+{
+    struct ParticipantResult
+    {
+        std::string _name;
+        transition_statistics::LatencyHistogram _latencies;
+        /// wall time of all calls to the participant
+        std::chrono::steady_clock::duration _duration{};
+        /// set if the benchmark of the participant was aborted
+        std::string _error;
+    };
+
+    /**
+     * Calls IRPCParticipantInfo::getRPCComponents @p calls times on each of @p participant_names,
+     * benchmarking at most @p concurrency participants at the same time.
+     * The calls to one participant are sequential, so the latencies are round trip times of an idle server.
+     * A failing call aborts the benchmark of that participant only and invalidates its cached proxies.
+     */
+    std::vector<ParticipantResult> run(fep3::System& system,
+                                       rpc_proxy_cache::ProxyCache& proxies,
+                                       const std::vector<std::string>& participant_names,
+                                       size_t calls,
+                                       size_t concurrency);
+
+    /// prints one line with count, failures, percentiles (in ms) and calls/s per participant and a total line
+    void print(std::ostream& out,
+               const std::vector<ParticipantResult>& results,
+               std::chrono::steady_clock::duration total_duration);
+}
@@ -0,0 +1,284 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "rpc_call.h"
+
+#include <cctype>
+#include <stdexcept>
+
+#include "control_tool_common_helper.h"
+
+namespace
+{
+    void skipWhitespace(const std::string& json, size_t& position)
+    {
+        while (position < json.size() && std::isspace(static_cast<unsigned char>(json[position])))
+        {
+            ++position;
+        }
+    }
+
+    bool parseString(const std::string& json, size_t& position, std::string& value)
+    {
+        if (position >= json.size() || json[position] != '"')
+        {
+            return false;
+        }
+        value.clear();
+        for (++position; position < json.size(); ++position)
+        {
+            const char character = json[position];
+            if (character == '"')
+            {
+                ++position;
+                return true;
+            }
+            if (character != '\\')
+            {
+                value += character;
+                continue;
+            }
+            if (++position >= json.size())
+            {
+                return false;
+            }
+            switch (json[position])
+            {
+                case 'n': value += '\n'; break;
+                case 'r': value += '\r'; break;
+                case 't': value += '\t'; break;
+                case 'b': value += '\b'; break;
+                case 'f': value += '\f'; break;
+                case 'u':
+                {
+                    //only the ASCII range, the parameters are names
+                    if (position + 4u >= json.size())
+                    {
+                        return false;
+                    }
+                    const auto digits = json.substr(position + 1u, 4u);
+                    for (const char digit : digits)
+                    {
+                        if (!std::isxdigit(static_cast<unsigned char>(digit)))
+                        {
+                            return false;
+                        }
+                    }
+                    const auto code = std::stoul(digits, nullptr, 16);
+                    if (code > 0x7fu)
+                    {
+                        return false;
+                    }
+                    value += static_cast<char>(code);
+                    position += 4u;
+                    break;
+                }
+                default: value += json[position]; break;
+            }
+        }
+        return false;
+    }
+
+    template <typename Interface>
+    fep3::RPCComponent<Interface> getComponent(rpc_proxy_cache::ProxyCache& proxies,
+                                               const fep3::System& system,
+                                               const std::string& participant_name)
+    {
+        auto component = proxies.getComponent<Interface>(system, participant_name);
+        if (!component)
+        {
+            throw std::runtime_error("participant \"" + participant_name + "\" has no RPC object \""
+                + Interface::getRPCDefaultName() + "\"");
+        }
+        return component;
+    }
+
+    std::string toJson(const std::string& value)
+    {
+        return "\"" + escapeJsonString(value) + "\"";
+    }
+
+    std::string toJson(const std::vector<std::string>& values)
+    {
+        std::string json = "[";
+        for (const auto& value : values)
+        {
+            json += (json.size() > 1u ? "," : "") + toJson(value);
+        }
+        return json + "]";
+    }
+
+    template <typename Interface>
+    rpc_call::Method makeMethod(const std::string& name, size_t parameter_count, rpc_call::Method::Call call)
+    {
+        return { Interface::getRPCIID(), Interface::getRPCDefaultName(), name, parameter_count, std::move(call) };
+    }
+
+    typedef fep3::RPCComponent<fep3::rpc::arya::IRPCParticipantStateMachine> StateMachineProxy;
+
+    rpc_call::Method makeStateMachineCall(const std::string& name, std::function<void(StateMachineProxy&)> transition)
+    {
+        return makeMethod<fep3::rpc::arya::IRPCParticipantStateMachine>(name, 0u,
+            [transition](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>&)
+            {
+                auto state_machine = getComponent<fep3::rpc::arya::IRPCParticipantStateMachine>(proxies, system, participant_name);
+                transition(state_machine);
+                return std::string("null");
+            });
+    }
+}
+
+bool rpc_call::parseParameters(const std::string& json, std::vector<std::string>& parameters, std::string& error)
+{
+    parameters.clear();
+    size_t position = 0u;
+    skipWhitespace(json, position);
+    if (position >= json.size() || (json[position] != '[' && json[position] != '{'))
+    {
+        error = "parameters must be a JSON array or object";
+        return false;
+    }
+    const bool is_object = json[position] == '{';
+    const char closing = is_object ? '}' : ']';
+    ++position;
+    skipWhitespace(json, position);
+    if (position < json.size() && json[position] == closing)
+    {
+        ++position;
+    }
+    else
+    {
+        for (;;)
+        {
+            std::string value;
+            if (is_object)
+            {
+                skipWhitespace(json, position);
+                if (!parseString(json, position, value))
+                {
+                    error = "expected a string key at position " + std::to_string(position);
+                    return false;
+                }
+                skipWhitespace(json, position);
+                if (position >= json.size() || json[position] != ':')
+                {
+                    error = "expected ':' at position " + std::to_string(position);
+                    return false;
+                }
+                ++position;
+            }
+            skipWhitespace(json, position);
+            if (!parseString(json, position, value))
+            {
+                error = "expected a string value at position " + std::to_string(position);
+                return false;
+            }
+            parameters.push_back(value);
+            skipWhitespace(json, position);
+            if (position < json.size() && json[position] == ',')
+            {
+                ++position;
+                continue;
+            }
+            if (position < json.size() && json[position] == closing)
+            {
+                ++position;
+                break;
+            }
+            error = std::string("expected ',' or '") + closing + "' at position " + std::to_string(position);
+            return false;
+        }
+    }
+    skipWhitespace(json, position);
+    if (position != json.size())
+    {
+        error = "unexpected characters after the parameters at position " + std::to_string(position);
+        return false;
+    }
+    return true;
+}
+
+const std::vector<rpc_call::Method>& rpc_call::getMethods()
+{
+    using fep3::rpc::arya::IRPCParticipantStateMachine;
+    using fep3::rpc::arya::IRPCParticipantInfo;
+    static const std::vector<Method> methods = {
+        makeStateMachineCall("load", [](StateMachineProxy& state_machine) { state_machine->load(); }),
+        makeStateMachineCall("unload", [](StateMachineProxy& state_machine) { state_machine->unload(); }),
+        makeStateMachineCall("initialize", [](StateMachineProxy& state_machine) { state_machine->initialize(); }),
+        makeStateMachineCall("deinitialize", [](StateMachineProxy& state_machine) { state_machine->deinitialize(); }),
+        makeStateMachineCall("start", [](StateMachineProxy& state_machine) { state_machine->start(); }),
+        makeStateMachineCall("stop", [](StateMachineProxy& state_machine) { state_machine->stop(); }),
+        makeStateMachineCall("pause", [](StateMachineProxy& state_machine) { state_machine->pause(); }),
+        makeStateMachineCall("shutdown", [](StateMachineProxy& state_machine) { state_machine->shutdown(); }),
+        makeMethod<IRPCParticipantStateMachine>("getState", 0u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>&)
+            {
+                auto state_machine = getComponent<IRPCParticipantStateMachine>(proxies, system, participant_name);
+                return std::to_string(int(state_machine->getState()));
+            }),
+        makeMethod<IRPCParticipantInfo>("getName", 0u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>&)
+            {
+                return toJson(getComponent<IRPCParticipantInfo>(proxies, system, participant_name)->getName());
+            }),
+        makeMethod<IRPCParticipantInfo>("getSystemName", 0u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>&)
+            {
+                return toJson(getComponent<IRPCParticipantInfo>(proxies, system, participant_name)->getSystemName());
+            }),
+        makeMethod<IRPCParticipantInfo>("getRPCComponents", 0u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>&)
+            {
+                return toJson(getComponent<IRPCParticipantInfo>(proxies, system, participant_name)->getRPCComponents());
+            }),
+        makeMethod<IRPCParticipantInfo>("getRPCComponentIIDs", 1u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>& parameters)
+            {
+                return toJson(getComponent<IRPCParticipantInfo>(proxies, system, participant_name)->getRPCComponentIIDs(parameters[0]));
+            }),
+        makeMethod<IRPCParticipantInfo>("getRPCComponentInterfaceDefinition", 2u,
+            [](rpc_proxy_cache::ProxyCache& proxies, const fep3::System& system,
+                const std::string& participant_name, const std::vector<std::string>& parameters)
+            {
+                return toJson(getComponent<IRPCParticipantInfo>(proxies, system, participant_name)
+                    ->getRPCComponentInterfaceDefinition(parameters[0], parameters[1]));
+            })
+    };
+    return methods;
+}
+
+const rpc_call::Method* rpc_call::findMethod(const std::string& iid, const std::string& method_name)
+{
+    for (const auto& method : getMethods())
+    {
+        if (method._iid == iid && method._name == method_name)
+        {
+            return &method;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,61 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+
+namespace rpc_call
+{
+    /**
+     * Parses the parameters of a call, given as JSON array of strings (["a", "b"]) or as JSON object
+     * with string values ({"service_name": "a"}), in which case the values are taken in order.
+     * Returns false and sets @p error for anything else.
+     */
+    bool parseParameters(const std::string& json, std::vector<std::string>& parameters, std::string& error);
+
+    /**
+     * One RPC method the tool has a client for. The participant proxy only offers typed clients,
+     * so calls are dispatched to them by IID and method name.
+     * The result is returned as JSON.
+     */
+    struct Method
+    {
+        typedef std::function<std::string(rpc_proxy_cache::ProxyCache& proxies,
+                                          const fep3::System& system,
+                                          const std::string& participant_name,
+                                          const std::vector<std::string>& parameters)> Call;
+
+        std::string _iid;
+        std::string _object;
+        std::string _name;
+        size_t _parameter_count;
+        Call _call;
+    };
+
+    const std::vector<Method>& getMethods();
+    /// returns nullptr if there is no client for the method
+    const Method* findMethod(const std::string& iid, const std::string& method_name);
+}
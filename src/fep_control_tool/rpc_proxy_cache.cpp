@@ -0,0 +1,71 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "rpc_proxy_cache.h"
+
+fep3::ParticipantProxy rpc_proxy_cache::ProxyCache::getParticipant(const fep3::System& system, const std::string& participant_name)
+{
+    const auto participant_id = symbol_table::getSymbols().intern(participant_name);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _participants.find(participant_id);
+        if (it != _participants.end())
+        {
+            return it->second;
+        }
+    }
+    auto participant = system.getParticipant(participant_name);
+    if (participant)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _participants.emplace(participant_id, participant);
+    }
+    return participant;
+}
+
+void rpc_proxy_cache::ProxyCache::invalidate(const std::string& participant_name)
+{
+    symbol_table::SymbolId participant_id;
+    if (!symbol_table::getSymbols().find(participant_name, participant_id))
+    {
+        //never cached
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _participants.erase(participant_id);
+    for (auto it = _components.begin(); it != _components.end();)
+    {
+        if (it->first.first == participant_id)
+        {
+            it = _components.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+void rpc_proxy_cache::ProxyCache::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _participants.clear();
+    _components.clear();
+}
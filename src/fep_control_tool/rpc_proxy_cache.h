@@ -0,0 +1,87 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <utility>
+
+#include <fep_system/fep_system.h>
+
+#include "symbol_table.h"
+
+namespace rpc_proxy_cache
+{
+    /**
+     * Caches the participant proxies of one system and the RPC component proxies resolved from them,
+     * keyed by (interned participant name, interface). Resolving a component proxy sets up a new RPC client,
+     * so repeated commands on the same participant reuse the cached one.
+     * Entries of a participant have to be invalidated if it is shut down, renamed or an RPC call failed.
+     * All methods are thread safe, the returned proxies are copies and stay usable after an invalidation.
+     */
+    class ProxyCache
+    {
+    public:
+        /// returns an invalid proxy if the participant is not in @p system
+        fep3::ParticipantProxy getParticipant(const fep3::System& system, const std::string& participant_name);
+
+        /// returns an invalid component if the participant is not in @p system or has no such component
+        template <typename Interface>
+        fep3::RPCComponent<Interface> getComponent(const fep3::System& system, const std::string& participant_name)
+        {
+            const ComponentKey key(symbol_table::getSymbols().intern(participant_name), std::type_index(typeid(Interface)));
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _components.find(key);
+                if (it != _components.end())
+                {
+                    return *std::static_pointer_cast<fep3::RPCComponent<Interface>>(it->second);
+                }
+            }
+            auto participant = getParticipant(system, participant_name);
+            if (!participant)
+            {
+                return fep3::RPCComponent<Interface>();
+            }
+            //the proxy is resolved outside of the lock, a concurrent miss for the same key keeps the first one
+            auto component = std::make_shared<fep3::RPCComponent<Interface>>(participant.template getRPCComponentProxy<Interface>());
+            if (!*component)
+            {
+                return *component;
+            }
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto inserted = _components.emplace(key, component);
+            return *std::static_pointer_cast<fep3::RPCComponent<Interface>>(inserted.first->second);
+        }
+
+        /// drops the participant proxy and all component proxies of the participant
+        void invalidate(const std::string& participant_name);
+        void clear();
+
+    private:
+        typedef std::pair<symbol_table::SymbolId, std::type_index> ComponentKey;
+
+        std::mutex _mutex;
+        std::map<symbol_table::SymbolId, fep3::ParticipantProxy> _participants;
+        std::map<ComponentKey, std::shared_ptr<void>> _components;
+    };
+}
@@ -0,0 +1,74 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "symbol_table.h"
+
+symbol_table::SymbolId symbol_table::SymbolTable::intern(const std::string& name)
+{
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+        auto it = _index.find(&name);
+        if (it != _index.end())
+        {
+            return it->second;
+        }
+    }
+    std::unique_lock<std::shared_timed_mutex> lock(_mutex);
+    //another thread might have added it in between
+    auto it = _index.find(&name);
+    if (it != _index.end())
+    {
+        return it->second;
+    }
+    const auto id = static_cast<SymbolId>(_names.size());
+    _names.push_back(name);
+    _index.emplace(&_names.back(), id);
+    return id;
+}
+
+bool symbol_table::SymbolTable::find(const std::string& name, SymbolId& id) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    auto it = _index.find(&name);
+    if (it == _index.end())
+    {
+        return false;
+    }
+    id = it->second;
+    return true;
+}
+
+const std::string& symbol_table::SymbolTable::getName(SymbolId id) const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    return _names.at(id);
+}
+
+size_t symbol_table::SymbolTable::size() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    return _names.size();
+}
+
+symbol_table::SymbolTable& symbol_table::getSymbols()
+{
+    static SymbolTable symbols;
+    return symbols;
+}
@@ -0,0 +1,73 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace symbol_table
+{
+    typedef uint32_t SymbolId;
+
+    /**
+     * Interns names, so subsystems can store and compare 32 bit ids instead of copies of the strings:
+     * system, participant and transition names of the transition statistics and participant names
+     * of the RPC proxy cache. Symbols are never removed, ids and the references
+     * returned by getName stay valid for the lifetime of the table. All methods are thread safe.
+     */
+    class SymbolTable
+    {
+    public:
+        /// returns the id of @p name, adds it if it is not known yet
+        SymbolId intern(const std::string& name);
+        /// returns false if @p name was never interned
+        bool find(const std::string& name, SymbolId& id) const;
+        const std::string& getName(SymbolId id) const;
+        size_t size() const;
+
+    private:
+        struct Hash
+        {
+            size_t operator()(const std::string* name) const
+            {
+                return std::hash<std::string>()(*name);
+            }
+        };
+        struct Equal
+        {
+            bool operator()(const std::string* lhs, const std::string* rhs) const
+            {
+                return *lhs == *rhs;
+            }
+        };
+
+        mutable std::shared_timed_mutex _mutex;
+        /// a deque does not move its elements, the index points into it
+        std::deque<std::string> _names;
+        std::unordered_map<const std::string*, SymbolId, Hash, Equal> _index;
+    };
+
+    /// the table shared by all subsystems of the tool
+    SymbolTable& getSymbols();
+}
@@ -0,0 +1,501 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "system_properties.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include <a_util/strings.h>
+#include <a_util/xml.h>
+
+#include "control_tool_common_helper.h"
+
+#include "worker_pool.h"
+
+namespace
+{
+    typedef std::map<std::string, std::shared_ptr<fep3::IProperties>> NodeProxies;
+
+    std::string getChildData(const a_util::xml::DOMElement& element, const std::string& child_name)
+    {
+        a_util::xml::DOMElement child;
+        if (!element.findNode(child_name, child))
+        {
+            throw std::runtime_error("\"" + element.getName() + "\" without \"" + child_name + "\"");
+        }
+        return child.getData();
+    }
+
+    void appendProperties(const a_util::xml::DOMElement& section, std::vector<system_properties::Property>& properties)
+    {
+        for (const auto& child : section.getChildren())
+        {
+            if (child.getName() == "property")
+            {
+                properties.push_back({ getChildData(child, "name"), getChildData(child, "type"), getChildData(child, "value") });
+            }
+            else if (child.getName() == "properties")
+            {
+                appendProperties(child, properties);
+            }
+        }
+    }
+
+    fep3::RPCComponent<fep3::rpc::IRPCConfiguration> getConfiguration(fep3::System& system,
+                                                                      rpc_proxy_cache::ProxyCache& proxies,
+                                                                      const std::string& participant_name)
+    {
+        auto configuration = proxies.getComponent<fep3::rpc::IRPCConfiguration>(system, participant_name);
+        if (!configuration)
+        {
+            throw std::runtime_error("participant \"" + participant_name + "\" has no RPC configuration");
+        }
+        return configuration;
+    }
+
+    /// resolves every node once, returns nullptr if the node does not exist
+    std::shared_ptr<fep3::IProperties> getNodeProxy(const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+                                                    NodeProxies& nodes,
+                                                    const std::string& node_path)
+    {
+        auto it = nodes.find(node_path);
+        if (it == nodes.end())
+        {
+            it = nodes.emplace(node_path, configuration->getProperties(node_path)).first;
+        }
+        return it->second;
+    }
+
+    /// returns the node of the property @p path and sets @p name to the name of the property in the node
+    std::shared_ptr<fep3::IProperties> getNode(const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+                                               NodeProxies& nodes,
+                                               const std::string& path,
+                                               std::string& name)
+    {
+        std::string node_path;
+        system_properties::splitPath(path, node_path, name);
+        return getNodeProxy(configuration, nodes, node_path);
+    }
+
+    /// descends only into the nodes matching the pattern segment of their level
+    void collectMatching(const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+                         NodeProxies& nodes,
+                         const std::string& node_path,
+                         const std::vector<std::string>& segments,
+                         size_t level,
+                         std::vector<system_properties::Property>& properties)
+    {
+        const auto node = getNodeProxy(configuration, nodes, node_path);
+        if (!node)
+        {
+            return;
+        }
+        for (const auto& name : node->getPropertyNames())
+        {
+            if (!matchesWildcard(segments[level], name))
+            {
+                continue;
+            }
+            const auto path = node_path == "/" ? name : node_path + "/" + name;
+            if (level + 1u == segments.size())
+            {
+                properties.push_back({ path, node->getPropertyType(name), node->getProperty(name) });
+            }
+            else
+            {
+                collectMatching(configuration, nodes, path, segments, level + 1u, properties);
+            }
+        }
+    }
+
+    /// every property is a node as well, so all of them are listed for children
+    void collectAll(const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+                    NodeProxies& nodes,
+                    const std::string& node_path,
+                    std::vector<system_properties::Property>& properties)
+    {
+        const auto node = getNodeProxy(configuration, nodes, node_path);
+        if (!node)
+        {
+            return;
+        }
+        for (const auto& name : node->getPropertyNames())
+        {
+            const auto path = node_path == "/" ? name : node_path + "/" + name;
+            properties.push_back({ path, node->getPropertyType(name), node->getProperty(name) });
+            collectAll(configuration, nodes, path, properties);
+        }
+    }
+
+    typedef std::function<void(const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+                               NodeProxies& nodes,
+                               std::vector<system_properties::Property>& properties)> CollectFunction;
+
+    void readParticipants(fep3::System& system,
+                          rpc_proxy_cache::ProxyCache& proxies,
+                          const std::vector<std::string>& participant_names,
+                          size_t concurrency,
+                          const system_properties::ResultCallback& on_result,
+                          const CollectFunction& collect)
+    {
+        worker_pool::parallelFor(participant_names.size(), concurrency,
+            [&](size_t index)
+            {
+                const auto& participant_name = participant_names[index];
+                std::vector<system_properties::Property> properties;
+                std::string error;
+                try
+                {
+                    const auto configuration = getConfiguration(system, proxies, participant_name);
+                    NodeProxies nodes;
+                    collect(configuration, nodes, properties);
+                    std::sort(properties.begin(), properties.end(),
+                        [](const system_properties::Property& lhs, const system_properties::Property& rhs)
+                        {
+                            return lhs._path < rhs._path;
+                        });
+                }
+                catch (const std::exception& e)
+                {
+                    error = e.what();
+                    proxies.invalidate(participant_name);
+                }
+                on_result(participant_name, properties, error);
+            });
+    }
+
+    void computeParticipantDelta(fep3::System& system,
+                                 rpc_proxy_cache::ProxyCache& proxies,
+                                 const std::vector<system_properties::Property>& properties,
+                                 system_properties::ParticipantDelta& delta)
+    {
+        try
+        {
+            const auto configuration = getConfiguration(system, proxies, delta._name);
+            NodeProxies nodes;
+            std::string name;
+            for (const auto& property : properties)
+            {
+                const auto node = getNode(configuration, nodes, property._path, name);
+                if (node && node->getProperty(name) == property._value)
+                {
+                    ++delta._unchanged;
+                }
+                else
+                {
+                    delta._changed.push_back(property);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            delta._error = e.what();
+            delta._changed = properties;
+            delta._unchanged = 0u;
+            proxies.invalidate(delta._name);
+        }
+    }
+
+    void pushParticipant(fep3::System& system,
+                         rpc_proxy_cache::ProxyCache& proxies,
+                         const std::vector<system_properties::Property>& properties,
+                         system_properties::PushResult& result)
+    {
+        try
+        {
+            const auto configuration = getConfiguration(system, proxies, result._name);
+            NodeProxies nodes;
+            std::string name;
+            for (const auto& property : properties)
+            {
+                const auto node = getNode(configuration, nodes, property._path, name);
+                if (node && node->setProperty(name, property._value, property._type))
+                {
+                    ++result._set;
+                }
+                else
+                {
+                    result._failed.push_back(property._path);
+                }
+            }
+        }
+        catch (const std::exception& e)
+        {
+            result._error = e.what();
+            proxies.invalidate(result._name);
+        }
+    }
+
+    std::string escapeXml(const std::string& value)
+    {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (const char character : value)
+        {
+            switch (character)
+            {
+            case '&': escaped += "&amp;"; break;
+            case '<': escaped += "&lt;"; break;
+            case '>': escaped += "&gt;"; break;
+            default: escaped += character;
+            }
+        }
+        return escaped;
+    }
+}
+
+bool system_properties::operator==(const Property& lhs, const Property& rhs)
+{
+    return lhs._path == rhs._path && lhs._type == rhs._type && lhs._value == rhs._value;
+}
+
+bool system_properties::operator!=(const Property& lhs, const Property& rhs)
+{
+    return !(lhs == rhs);
+}
+
+system_properties::PropertyFile system_properties::load(const std::string& file_name)
+{
+    a_util::xml::DOM dom;
+    if (!dom.load(file_name))
+    {
+        throw std::runtime_error("cannot parse \"" + file_name + "\": " + dom.getLastError());
+    }
+    PropertyFile file;
+    for (const auto& section : dom.getRoot().getChildren())
+    {
+        if (section.getName() == "system_properties")
+        {
+            appendProperties(section, file._system_properties);
+        }
+        else if (section.getName() == "system_timing_properties")
+        {
+            appendProperties(section, file._timing_properties);
+        }
+        else if (section.getName() == "element_instances_properties")
+        {
+            for (const auto& element : section.getChildren())
+            {
+                appendProperties(element, file._element_properties[getChildData(element, "name")]);
+            }
+        }
+    }
+    return file;
+}
+
+std::map<std::string, std::vector<system_properties::Property>> system_properties::resolve(
+    const PropertyFile& file,
+    const std::vector<std::string>& participant_names)
+{
+    std::map<std::string, std::vector<Property>> resolved;
+    for (const auto& participant_name : participant_names)
+    {
+        auto& properties = resolved[participant_name];
+        properties = file._system_properties;
+        const auto element = file._element_properties.find(participant_name);
+        if (element == file._element_properties.end())
+        {
+            continue;
+        }
+        for (const auto& element_property : element->second)
+        {
+            auto existing = std::find_if(properties.begin(), properties.end(),
+                [&](const Property& property) { return property._path == element_property._path; });
+            if (existing != properties.end())
+            {
+                *existing = element_property;
+            }
+            else
+            {
+                properties.push_back(element_property);
+            }
+        }
+    }
+    return resolved;
+}
+
+void system_properties::splitPath(const std::string& path, std::string& node, std::string& name)
+{
+    const auto separator = path.rfind('/');
+    if (separator == std::string::npos || separator == 0u)
+    {
+        node = "/";
+        name = separator == 0u ? path.substr(1u) : path;
+        return;
+    }
+    node = path.substr(0u, separator);
+    name = path.substr(separator + 1u);
+}
+
+std::vector<system_properties::ParticipantDelta> system_properties::computeDelta(
+    fep3::System& system,
+    rpc_proxy_cache::ProxyCache& proxies,
+    const std::map<std::string, std::vector<Property>>& properties,
+    size_t concurrency)
+{
+    std::vector<const std::vector<Property>*> participant_properties;
+    std::vector<ParticipantDelta> deltas;
+    for (const auto& participant : properties)
+    {
+        deltas.emplace_back();
+        deltas.back()._name = participant.first;
+        participant_properties.push_back(&participant.second);
+    }
+    worker_pool::parallelFor(deltas.size(), concurrency,
+        [&](size_t index)
+        {
+            computeParticipantDelta(system, proxies, *participant_properties[index], deltas[index]);
+        });
+    return deltas;
+}
+
+std::vector<system_properties::PushResult> system_properties::push(
+    fep3::System& system,
+    rpc_proxy_cache::ProxyCache& proxies,
+    const std::map<std::string, std::vector<Property>>& properties,
+    size_t concurrency)
+{
+    std::vector<const std::vector<Property>*> participant_properties;
+    std::vector<PushResult> results;
+    for (const auto& participant : properties)
+    {
+        results.emplace_back();
+        results.back()._name = participant.first;
+        participant_properties.push_back(&participant.second);
+    }
+    worker_pool::parallelFor(results.size(), concurrency,
+        [&](size_t index)
+        {
+            pushParticipant(system, proxies, *participant_properties[index], results[index]);
+        });
+    return results;
+}
+
+void system_properties::writeTimingFile(const std::string& file_name, const std::vector<Property>& timing_properties)
+{
+    std::ofstream file(file_name, std::ios::trunc);
+    file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+    file << "<property_file xmlns=\"http://fep.vwgroup.com/system/2.0/properties\">\n";
+    file << "    <schema_version>2.0.0</schema_version>\n";
+    file << "    <system_timing_properties>\n";
+    for (const auto& property : timing_properties)
+    {
+        file << "        <property>\n";
+        file << "            <name>" << escapeXml(property._path) << "</name>\n";
+        file << "            <type>" << escapeXml(property._type) << "</type>\n";
+        file << "            <value>" << escapeXml(property._value) << "</value>\n";
+        file << "        </property>\n";
+    }
+    file << "    </system_timing_properties>\n";
+    file << "    <system_properties/>\n";
+    file << "    <element_instances_properties/>\n";
+    file << "</property_file>\n";
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("cannot write \"" + file_name + "\"");
+    }
+}
+
+void system_properties::get(fep3::System& system,
+                            rpc_proxy_cache::ProxyCache& proxies,
+                            const std::vector<std::string>& participant_names,
+                            const std::string& path_pattern,
+                            size_t concurrency,
+                            const ResultCallback& on_result)
+{
+    std::vector<std::string> segments;
+    for (const auto& segment : a_util::strings::split(path_pattern, "/"))
+    {
+        if (!segment.empty())
+        {
+            segments.push_back(segment);
+        }
+    }
+    readParticipants(system, proxies, participant_names, concurrency, on_result,
+        [&](const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+            NodeProxies& nodes,
+            std::vector<Property>& properties)
+        {
+            if (!segments.empty())
+            {
+                collectMatching(configuration, nodes, "/", segments, 0u, properties);
+            }
+        });
+}
+
+void system_properties::getAll(fep3::System& system,
+                               rpc_proxy_cache::ProxyCache& proxies,
+                               const std::vector<std::string>& participant_names,
+                               size_t concurrency,
+                               const ResultCallback& on_result)
+{
+    readParticipants(system, proxies, participant_names, concurrency, on_result,
+        [&](const fep3::RPCComponent<fep3::rpc::IRPCConfiguration>& configuration,
+            NodeProxies& nodes,
+            std::vector<Property>& properties)
+        {
+            collectAll(configuration, nodes, "/", properties);
+        });
+}
+
+void system_properties::set(fep3::System& system,
+                            rpc_proxy_cache::ProxyCache& proxies,
+                            const std::vector<std::string>& participant_names,
+                            const std::vector<std::pair<std::string, std::string>>& values,
+                            size_t concurrency,
+                            const std::function<void(const PushResult& result)>& on_result)
+{
+    worker_pool::parallelFor(participant_names.size(), concurrency,
+        [&](size_t index)
+        {
+            PushResult result;
+            result._name = participant_names[index];
+            try
+            {
+                const auto configuration = getConfiguration(system, proxies, result._name);
+                NodeProxies nodes;
+                std::string name;
+                for (const auto& value : values)
+                {
+                    //the type of an existing property is kept, unknown properties are refused
+                    const auto node = getNode(configuration, nodes, value.first, name);
+                    const auto type = node ? node->getPropertyType(name) : std::string();
+                    if (!type.empty() && node->setProperty(name, value.second, type))
+                    {
+                        ++result._set;
+                    }
+                    else
+                    {
+                        result._failed.push_back(value.first);
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                result._error = e.what();
+                proxies.invalidate(result._name);
+            }
+            on_result(result);
+        });
+}
@@ -0,0 +1,151 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+
+namespace system_properties
+{
+    struct Property
+    {
+        /// full property path like "clock/step_size"
+        std::string _path;
+        std::string _type;
+        std::string _value;
+    };
+
+    bool operator==(const Property& lhs, const Property& rhs);
+    bool operator!=(const Property& lhs, const Property& rhs);
+
+    /// content of a FEP system properties file (see DEMO.properties)
+    struct PropertyFile
+    {
+        /// set on every participant
+        std::vector<Property> _system_properties;
+        /// participant name -> properties set on this participant only, overriding the system properties
+        std::map<std::string, std::vector<Property>> _element_properties;
+        /// timing configuration, applied through the system and not as participant properties
+        std::vector<Property> _timing_properties;
+    };
+
+    /**
+     * Parses the sections "system_properties", "element_instances_properties" and "system_timing_properties".
+     * Every "property" has the children "name", "type" and "value". Every child of "element_instances_properties"
+     * names its participant with a "name" child and contains "property" children, optionally grouped in "properties".
+     * Throws std::runtime_error if the file cannot be parsed.
+     */
+    PropertyFile load(const std::string& file_name);
+
+    /**
+     * Returns the properties of each of @p participant_names, the system properties followed by
+     * the element properties, the latter replacing system properties with the same path.
+     */
+    std::map<std::string, std::vector<Property>> resolve(const PropertyFile& file,
+                                                         const std::vector<std::string>& participant_names);
+
+    /// splits "a/b/c" into the node "a/b" and the name "c", the node of top level properties is "/"
+    void splitPath(const std::string& path, std::string& node, std::string& name);
+
+    struct ParticipantDelta
+    {
+        std::string _name;
+        /// properties whose current value differs from the wanted one or could not be read
+        std::vector<Property> _changed;
+        size_t _unchanged = 0u;
+        /// set if the participant could not be queried, all properties are in _changed then
+        std::string _error;
+    };
+
+    /**
+     * Reads the current values of @p properties through IRPCConfiguration, at most @p concurrency participants
+     * at the same time, and returns the properties that have to be set, per participant in the order of @p properties.
+     * The properties of one node are read through one IProperties proxy.
+     */
+    std::vector<ParticipantDelta> computeDelta(fep3::System& system,
+                                               rpc_proxy_cache::ProxyCache& proxies,
+                                               const std::map<std::string, std::vector<Property>>& properties,
+                                               size_t concurrency);
+
+    struct PushResult
+    {
+        std::string _name;
+        size_t _set = 0u;
+        /// paths of the properties the participant refused
+        std::vector<std::string> _failed;
+        /// set if the participant could not be reached, the remaining properties were not set then
+        std::string _error;
+    };
+
+    /**
+     * Sets the properties of each participant in @p properties, at most @p concurrency participants at the same time.
+     * A refused property does not stop the others, failures are collected per participant.
+     * The cached proxies of participants that could not be reached are invalidated.
+     */
+    std::vector<PushResult> push(fep3::System& system,
+                                 rpc_proxy_cache::ProxyCache& proxies,
+                                 const std::map<std::string, std::vector<Property>>& properties,
+                                 size_t concurrency);
+
+    typedef std::function<void(const std::string& participant_name,
+                               const std::vector<Property>& properties,
+                               const std::string& error)> ResultCallback;
+
+    /**
+     * Reads the properties matching @p path_pattern of each participant, at most @p concurrency participants
+     * at the same time. Every segment of the pattern may contain the wildcards '*' and '?', only nodes matching
+     * their segment are listed. @p on_result is called from the worker threads as soon as a participant is done,
+     * with its properties sorted by path or with an error.
+     */
+    void get(fep3::System& system,
+             rpc_proxy_cache::ProxyCache& proxies,
+             const std::vector<std::string>& participant_names,
+             const std::string& path_pattern,
+             size_t concurrency,
+             const ResultCallback& on_result);
+
+    /// reads all properties of each participant by walking the whole property tree, otherwise like get
+    void getAll(fep3::System& system,
+                rpc_proxy_cache::ProxyCache& proxies,
+                const std::vector<std::string>& participant_names,
+                size_t concurrency,
+                const ResultCallback& on_result);
+
+    /**
+     * Sets the (path, value) pairs of @p values on each participant, keeping the current type of each property,
+     * at most @p concurrency participants at the same time. Unknown properties are refused.
+     * @p on_result is called from the worker threads as soon as a participant is done.
+     */
+    void set(fep3::System& system,
+             rpc_proxy_cache::ProxyCache& proxies,
+             const std::vector<std::string>& participant_names,
+             const std::vector<std::pair<std::string, std::string>>& values,
+             size_t concurrency,
+             const std::function<void(const PushResult& result)>& on_result);
+
+    /// writes a properties file with only the "system_timing_properties" section, throws std::runtime_error on failure
+    void writeTimingFile(const std::string& file_name, const std::vector<Property>& timing_properties);
+}
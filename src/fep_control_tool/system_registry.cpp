@@ -0,0 +1,145 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+#include "system_registry.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+system_registry::SystemEntry::SystemEntry(const std::string& name, fep3::System&& system)
+    : _name(name), _system(std::move(system))
+{
+}
+
+constexpr size_t system_registry::SystemRegistry::shard_count;
+
+system_registry::SystemRegistry::Shard& system_registry::SystemRegistry::getShard(const std::string& name)
+{
+    return _shards[std::hash<std::string>()(name) % shard_count];
+}
+
+const system_registry::SystemRegistry::Shard& system_registry::SystemRegistry::getShard(const std::string& name) const
+{
+    return _shards[std::hash<std::string>()(name) % shard_count];
+}
+
+system_registry::SystemHandle system_registry::SystemRegistry::find(const std::string& name) const
+{
+    const auto& shard = getShard(name);
+    std::shared_lock<std::shared_timed_mutex> lock(shard._mutex);
+    auto it = shard._systems.find(name);
+    return it == shard._systems.end() ? nullptr : it->second;
+}
+
+system_registry::SystemHandle system_registry::SystemRegistry::insertOrAssign(const std::string& name, fep3::System&& system)
+{
+    auto handle = std::make_shared<SystemEntry>(name, std::move(system));
+    SystemHandle replaced;
+    {
+        auto& shard = getShard(name);
+        std::unique_lock<std::shared_timed_mutex> lock(shard._mutex);
+        replaced = std::exchange(shard._systems[name], handle);
+    }
+    //the replaced system is destroyed outside of the lock
+    return handle;
+}
+
+std::pair<system_registry::SystemHandle, bool> system_registry::SystemRegistry::insert(const std::string& name, fep3::System&& system)
+{
+    auto& shard = getShard(name);
+    std::unique_lock<std::shared_timed_mutex> lock(shard._mutex);
+    auto it = shard._systems.find(name);
+    if (it != shard._systems.end())
+    {
+        return std::make_pair(it->second, false);
+    }
+    auto handle = std::make_shared<SystemEntry>(name, std::move(system));
+    shard._systems.emplace(name, handle);
+    return std::make_pair(handle, true);
+}
+
+bool system_registry::SystemRegistry::erase(const SystemHandle& handle)
+{
+    SystemHandle erased;
+    {
+        auto& shard = getShard(handle->_name);
+        std::unique_lock<std::shared_timed_mutex> lock(shard._mutex);
+        auto it = shard._systems.find(handle->_name);
+        if (it == shard._systems.end() || it->second != handle)
+        {
+            return false;
+        }
+        erased = std::move(it->second);
+        shard._systems.erase(it);
+    }
+    //the erased system is destroyed outside of the lock
+    return true;
+}
+
+void system_registry::SystemRegistry::clear()
+{
+    for (auto& shard : _shards)
+    {
+        std::map<std::string, SystemHandle> systems;
+        {
+            std::unique_lock<std::shared_timed_mutex> lock(shard._mutex);
+            systems.swap(shard._systems);
+        }
+        //the systems are destroyed outside of the lock
+    }
+}
+
+std::vector<system_registry::SystemHandle> system_registry::SystemRegistry::getAll() const
+{
+    std::vector<SystemHandle> handles;
+    for (const auto& shard : _shards)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(shard._mutex);
+        for (const auto& system : shard._systems)
+        {
+            handles.push_back(system.second);
+        }
+    }
+    std::sort(handles.begin(), handles.end(),
+        [](const SystemHandle& lhs, const SystemHandle& rhs) { return lhs->_name < rhs->_name; });
+    return handles;
+}
+
+std::vector<std::string> system_registry::SystemRegistry::getNames() const
+{
+    std::vector<std::string> names;
+    for (const auto& handle : getAll())
+    {
+        names.push_back(handle->_name);
+    }
+    return names;
+}
+
+void system_registry::SystemRegistry::setLastUsedName(const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(_last_used_name_mutex);
+    _last_used_name = name;
+}
+
+std::string system_registry::SystemRegistry::getLastUsedName() const
+{
+    std::lock_guard<std::mutex> lock(_last_used_name_mutex);
+    return _last_used_name;
+}
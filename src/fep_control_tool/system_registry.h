@@ -0,0 +1,108 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+#include "system_properties.h"
+
+namespace system_registry
+{
+    /**
+     * One connected or discovered system. Holders of a handle can keep using the entry
+     * after it was erased from (or replaced in) the registry.
+     */
+    struct SystemEntry
+    {
+        SystemEntry(const std::string& name, fep3::System&& system);
+
+        const std::string _name;
+        fep3::System _system;
+        /// serializes all operations on this system, operations on different systems run in parallel
+        std::mutex _operation_mutex;
+        /// dropped together with the entry if the system is shut down or replaced
+        rpc_proxy_cache::ProxyCache _proxies;
+        /// timing properties last applied by configureSystem, empty if unknown or changed by another command
+        std::vector<system_properties::Property> _applied_timing_properties;
+        /// set if the background discovery inserted the system, only such systems are pruned by it
+        std::atomic<bool> _inserted_by_discovery{ false };
+        /// consecutive background discoveries without the system, guarded by _operation_mutex
+        size_t _missed_discoveries = 0u;
+        /// consecutive background discoveries without the participant, guarded by _operation_mutex
+        std::map<std::string, size_t> _missed_participants;
+        /// init and start priority of participants the background discovery removed, restored if they join again
+        std::map<std::string, std::pair<int32_t, int32_t>> _removed_priorities;
+    };
+
+    typedef std::shared_ptr<SystemEntry> SystemHandle;
+
+    /**
+     * Thread safe map of system names to systems. The names are spread over shards,
+     * each guarded by its own reader/writer lock, so lookups never wait for each other
+     * and only writers to the same shard serialize.
+     */
+    class SystemRegistry
+    {
+    public:
+        /// returns nullptr if there is no such system
+        SystemHandle find(const std::string& name) const;
+        /// adds or replaces the system with the given name
+        SystemHandle insertOrAssign(const std::string& name, fep3::System&& system);
+        /// adds the system if the name is not used yet, the bool is false if it was
+        std::pair<SystemHandle, bool> insert(const std::string& name, fep3::System&& system);
+        /// erases the entry only if it is still registered with its name
+        bool erase(const SystemHandle& handle);
+        void clear();
+
+        /// snapshot of all entries sorted by name
+        std::vector<SystemHandle> getAll() const;
+        std::vector<std::string> getNames() const;
+
+        void setLastUsedName(const std::string& name);
+        std::string getLastUsedName() const;
+
+    private:
+        static constexpr size_t shard_count = 16u;
+
+        struct Shard
+        {
+            mutable std::shared_timed_mutex _mutex;
+            std::map<std::string, SystemHandle> _systems;
+        };
+
+        Shard& getShard(const std::string& name);
+        const Shard& getShard(const std::string& name) const;
+
+        std::array<Shard, shard_count> _shards;
+        mutable std::mutex _last_used_name_mutex;
+        std::string _last_used_name;
+    };
+}
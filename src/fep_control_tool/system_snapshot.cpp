@@ -0,0 +1,369 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "system_snapshot.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <a_util/strings.h>
+
+#include "content_hash.h"
+#include "system_state_table.h"
+#include "worker_pool.h"
+
+namespace
+{
+    /// keeps the record on one line
+    std::string toLine(std::string value)
+    {
+        std::replace(value.begin(), value.end(), '\n', ' ');
+        std::replace(value.begin(), value.end(), '\r', ' ');
+        return value;
+    }
+
+    void captureRPCObjects(const fep3::RPCComponent<fep3::rpc::IRPCParticipantInfo>& info,
+                           definition_cache::DefinitionCache& definitions,
+                           system_snapshot::ParticipantInfo& participant)
+    {
+        auto object_names = info->getRPCComponents();
+        std::sort(object_names.begin(), object_names.end());
+        for (const auto& object_name : object_names)
+        {
+            system_snapshot::RPCObjectInfo rpc_object;
+            rpc_object._name = object_name;
+            auto iids = info->getRPCComponentIIDs(object_name);
+            std::sort(iids.begin(), iids.end());
+            for (const auto& iid : iids)
+            {
+                system_snapshot::InterfaceInfo interface_info;
+                interface_info._iid = iid;
+                try
+                {
+                    interface_info._definition = definitions.get(iid,
+                        [&]()
+                        {
+                            return info->getRPCComponentInterfaceDefinition(object_name, iid);
+                        });
+                }
+                catch (const std::exception& e)
+                {
+                    interface_info._error = e.what();
+                }
+                rpc_object._interfaces.push_back(std::move(interface_info));
+            }
+            participant._rpc_objects.push_back(std::move(rpc_object));
+        }
+    }
+
+    system_snapshot::ParticipantInfo captureParticipant(fep3::System& system,
+                                                        rpc_proxy_cache::ProxyCache& proxies,
+                                                        definition_cache::DefinitionCache& definitions,
+                                                        const std::string& participant_name)
+    {
+        system_snapshot::ParticipantInfo participant;
+        participant._name = participant_name;
+        try
+        {
+            auto state_machine = proxies.getComponent<fep3::rpc::arya::IRPCParticipantStateMachine>(system, participant_name);
+            if (state_machine)
+            {
+                participant._state = state_machine->getState();
+                participant._has_state = true;
+            }
+            auto info = proxies.getComponent<fep3::rpc::arya::IRPCParticipantInfo>(system, participant_name);
+            if (info)
+            {
+                captureRPCObjects(info, definitions, participant);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            participant._error = e.what();
+            proxies.invalidate(participant_name);
+        }
+        return participant;
+    }
+}
+
+system_snapshot::SystemInfo system_snapshot::capture(const std::string& system_name,
+                                                     fep3::System& system,
+                                                     rpc_proxy_cache::ProxyCache& proxies,
+                                                     definition_cache::DefinitionCache& definitions,
+                                                     size_t concurrency)
+{
+    SystemInfo snapshot;
+    snapshot._name = system_name;
+    try
+    {
+        snapshot._state = system.getSystemState();
+        snapshot._timing_masters = system.getCurrentTimingMasters();
+    }
+    catch (const std::exception& e)
+    {
+        snapshot._error = e.what();
+    }
+
+    std::vector<std::string> participant_names;
+    for (const auto& participant : system.getParticipants())
+    {
+        participant_names.push_back(participant.getName());
+    }
+    std::sort(participant_names.begin(), participant_names.end());
+
+    snapshot._participants.resize(participant_names.size());
+    worker_pool::parallelFor(participant_names.size(), concurrency,
+        [&](size_t index)
+        {
+            snapshot._participants[index] = captureParticipant(system, proxies, definitions, participant_names[index]);
+        });
+    return snapshot;
+}
+
+void system_snapshot::write(std::ostream& out, const SystemInfo& snapshot)
+{
+    out << "fep_snapshot 1\n";
+    out << "system " << snapshot._name << "\n";
+    if (!snapshot._error.empty())
+    {
+        out << "error " << toLine(snapshot._error) << "\n";
+    }
+    else
+    {
+        out << "system_state ";
+        system_state_table::writeCode(out, snapshot._state._state);
+        out << " " << (snapshot._state._homogeneous ? 1 : 0) << "\n";
+        out << "timing_masters " << a_util::strings::join(snapshot._timing_masters, ",") << "\n";
+    }
+    for (const auto& participant : snapshot._participants)
+    {
+        out << "participant " << participant._name << "\n";
+        if (participant._has_state)
+        {
+            out << "state ";
+            system_state_table::writeCode(out, participant._state);
+            out << "\n";
+        }
+        for (const auto& rpc_object : participant._rpc_objects)
+        {
+            out << "rpc_object " << rpc_object._name << "\n";
+            for (const auto& interface_info : rpc_object._interfaces)
+            {
+                out << "iid " << interface_info._iid << "\n";
+                if (!interface_info._error.empty())
+                {
+                    out << "definition_error " << toLine(interface_info._error) << "\n";
+                    continue;
+                }
+                out << "definition " << interface_info._definition.size() << "\n";
+                out.write(interface_info._definition.data(), interface_info._definition.size());
+                out << "\n";
+            }
+        }
+        if (!participant._error.empty())
+        {
+            out << "error " << toLine(participant._error) << "\n";
+        }
+    }
+}
+
+system_snapshot::SectionReader::SectionReader(std::istream& in) : _in(in)
+{
+}
+
+bool system_snapshot::SectionReader::readLine(std::string& line)
+{
+    if (_has_pending_line)
+    {
+        _has_pending_line = false;
+        line.swap(_pending_line);
+        return true;
+    }
+    return static_cast<bool>(std::getline(_in, line));
+}
+
+bool system_snapshot::SectionReader::next(Section& section)
+{
+    std::string line;
+    if (_first)
+    {
+        _first = false;
+        if (!readLine(line) || line != "fep_snapshot 1")
+        {
+            throw std::runtime_error("not a snapshot document");
+        }
+        section._name = "system";
+    }
+    else
+    {
+        if (!readLine(line))
+        {
+            return false;
+        }
+        section._name = line;
+    }
+    section._records.clear();
+    section._definitions.clear();
+
+    content_hash::Hasher section_hasher;
+    std::string rpc_object;
+    std::string iid;
+    while (readLine(line))
+    {
+        if (line.compare(0u, 12u, "participant ") == 0)
+        {
+            _pending_line.swap(line);
+            _has_pending_line = true;
+            break;
+        }
+        section_hasher.update(line);
+        section_hasher.update("\n", 1u);
+        const auto separator = line.find(' ');
+        const std::string key = line.substr(0u, separator);
+        const std::string value = separator == std::string::npos ? "" : line.substr(separator + 1u);
+        if (key == "rpc_object")
+        {
+            rpc_object = value;
+            section._records["rpc_object " + rpc_object];
+        }
+        else if (key == "iid")
+        {
+            iid = rpc_object + "/" + value;
+            section._records["iid " + iid];
+        }
+        else if (key == "definition")
+        {
+            //the definition is hashed in chunks, it is never held in memory
+            size_t remaining = std::stoull(value);
+            content_hash::Hasher definition_hasher;
+            char buffer[65536];
+            while (remaining != 0u)
+            {
+                const auto chunk = std::min(remaining, sizeof(buffer));
+                if (!_in.read(buffer, chunk))
+                {
+                    throw std::runtime_error("truncated definition of " + iid + " in section \"" + section._name + "\"");
+                }
+                definition_hasher.update(buffer, chunk);
+                section_hasher.update(buffer, chunk);
+                remaining -= chunk;
+            }
+            _in.ignore(1);
+            section._definitions[iid] = definition_hasher.get();
+        }
+        else if (key == "definition_error")
+        {
+            section._records["definition_error " + iid] = value;
+        }
+        else
+        {
+            section._records[key] = value;
+        }
+    }
+    section._hash = section_hasher.get();
+    return true;
+}
+
+namespace
+{
+    bool diffSections(const system_snapshot::Section& before,
+                      const system_snapshot::Section& after,
+                      std::ostream& out)
+    {
+        bool equal = true;
+        for (const auto& record : before._records)
+        {
+            auto it = after._records.find(record.first);
+            if (it == after._records.end())
+            {
+                out << before._name << ": " << record.first << " removed" << std::endl;
+                equal = false;
+            }
+            else if (it->second != record.second)
+            {
+                out << before._name << ": " << record.first << " " << record.second << " -> " << it->second << std::endl;
+                equal = false;
+            }
+        }
+        for (const auto& record : after._records)
+        {
+            if (before._records.count(record.first) == 0u)
+            {
+                out << after._name << ": " << record.first << " added" << std::endl;
+                equal = false;
+            }
+        }
+        for (const auto& definition : before._definitions)
+        {
+            auto it = after._definitions.find(definition.first);
+            if (it != after._definitions.end() && it->second != definition.second)
+            {
+                out << before._name << ": definition of " << definition.first << " changed" << std::endl;
+                equal = false;
+            }
+        }
+        return equal;
+    }
+}
+
+bool system_snapshot::diff(std::istream& before, std::istream& after, std::ostream& out)
+{
+    std::map<std::string, Section> before_sections;
+    {
+        SectionReader reader(before);
+        Section section;
+        while (reader.next(section))
+        {
+            auto name = section._name;
+            before_sections[name] = std::move(section);
+        }
+    }
+
+    size_t unchanged = 0u;
+    size_t changed = 0u;
+    SectionReader reader(after);
+    Section section;
+    while (reader.next(section))
+    {
+        auto it = before_sections.find(section._name);
+        if (it == before_sections.end())
+        {
+            out << section._name << " added" << std::endl;
+            ++changed;
+            continue;
+        }
+        if (it->second._hash == section._hash || diffSections(it->second, section, out))
+        {
+            ++unchanged;
+        }
+        else
+        {
+            ++changed;
+        }
+        before_sections.erase(it);
+    }
+    for (const auto& removed : before_sections)
+    {
+        out << removed.first << " removed" << std::endl;
+        ++changed;
+    }
+    out << unchanged << " sections unchanged, " << changed << " changed" << std::endl;
+    return changed == 0u;
+}
@@ -0,0 +1,127 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "definition_cache.h"
+#include "rpc_proxy_cache.h"
+
+namespace system_snapshot
+{
+    struct InterfaceInfo
+    {
+        std::string _iid;
+        std::string _definition;
+        /// set if the definition could not be retrieved
+        std::string _error;
+    };
+
+    struct RPCObjectInfo
+    {
+        std::string _name;
+        std::vector<InterfaceInfo> _interfaces;
+    };
+
+    struct ParticipantInfo
+    {
+        std::string _name;
+        bool _has_state = false;
+        fep3::rpc::ParticipantState _state;
+        std::vector<RPCObjectInfo> _rpc_objects;
+        /// set if the participant could not be queried completely
+        std::string _error;
+    };
+
+    struct SystemInfo
+    {
+        std::string _name;
+        fep3::System::SystemState _state;
+        std::vector<std::string> _timing_masters;
+        std::string _error;
+        std::vector<ParticipantInfo> _participants;
+    };
+
+    /**
+     * Queries state, RPC objects, IIDs and interface definitions of all participants of @p system,
+     * at most @p concurrency participants at the same time. Failures are recorded per participant.
+     * Interface definitions are taken from @p definitions if possible.
+     * Participants, RPC objects and IIDs are sorted by name, so snapshots of the same topology are equal.
+     */
+    SystemInfo capture(const std::string& system_name,
+                       fep3::System& system,
+                       rpc_proxy_cache::ProxyCache& proxies,
+                       definition_cache::DefinitionCache& definitions,
+                       size_t concurrency);
+
+    /**
+     * Writes @p snapshot as one record per line ("<key> <value>"), starting with "fep_snapshot 1".
+     * Every participant starts a section with "participant <name>".
+     * Interface definitions are written as "definition <size>" followed by the raw definition and a newline,
+     * so the document can be read in one pass without buffering more than one definition.
+     * States are written as the compact code of system_state_table.
+     * The stream should be opened in binary mode.
+     */
+    void write(std::ostream& out, const SystemInfo& snapshot);
+
+    /**
+     * One section of a snapshot document, the header (named "system") or one participant
+     * (named "participant <name>"). Records are kept as "<key>" -> value, except definitions
+     * which are only kept as hash.
+     */
+    struct Section
+    {
+        std::string _name;
+        uint64_t _hash = 0u;
+        std::map<std::string, std::string> _records;
+        std::map<std::string, uint64_t> _definitions;
+    };
+
+    /// reads a snapshot document section by section, throws std::runtime_error on invalid documents
+    class SectionReader
+    {
+    public:
+        explicit SectionReader(std::istream& in);
+        /// returns false at the end of the document
+        bool next(Section& section);
+
+    private:
+        bool readLine(std::string& line);
+
+        std::istream& _in;
+        std::string _pending_line;
+        bool _has_pending_line = false;
+        bool _first = true;
+    };
+
+    /**
+     * Prints the differences of the snapshot documents @p before and @p after to @p out.
+     * @p before is read once keeping only record values and definition hashes,
+     * @p after is compared section by section and sections with equal hashes are skipped.
+     * Returns true if the documents are equal.
+     */
+    bool diff(std::istream& before, std::istream& after, std::ostream& out);
+}
@@ -0,0 +1,80 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "system_state_table.h"
+
+#include <cstring>
+
+namespace
+{
+    constexpr system_state_table::Text not_resolvable = system_state_table::text("NOT RESOLVABLE");
+}
+
+std::ostream& system_state_table::operator<<(std::ostream& out, Text text)
+{
+    return out.write(text._data, static_cast<std::streamsize>(text._size));
+}
+
+const system_state_table::StateEntry* system_state_table::findByInputName(const std::string& name)
+{
+    const auto entry = name_index._entries[hashName(name.data(), name.size())];
+    if (entry == no_entry)
+    {
+        return nullptr;
+    }
+    const auto& input_name = states[entry]._input_name;
+    if (input_name._size != name.size() || std::memcmp(input_name._data, name.data(), name.size()) != 0)
+    {
+        return nullptr;
+    }
+    return &states[entry];
+}
+
+system_state_table::Text system_state_table::getName(fep3::SystemAggregatedState state)
+{
+    const auto entry = find(state);
+    return entry ? entry->_name : not_resolvable;
+}
+
+void system_state_table::writeLine(std::ostream& out, fep3::SystemAggregatedState state)
+{
+    const auto entry = find(state);
+    if (entry)
+    {
+        out << entry->_line;
+    }
+    else
+    {
+        out << static_cast<int>(state) << " - " << not_resolvable;
+    }
+}
+
+void system_state_table::writeCode(std::ostream& out, fep3::SystemAggregatedState state)
+{
+    const auto entry = find(state);
+    if (entry)
+    {
+        out << entry->_code;
+    }
+    else
+    {
+        out << static_cast<int>(state);
+    }
+}
@@ -0,0 +1,140 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include <fep_system/fep_system.h>
+
+namespace system_state_table
+{
+    /// a string with static storage duration, streamed without allocation
+    struct Text
+    {
+        const char* _data;
+        size_t _size;
+    };
+
+    std::ostream& operator<<(std::ostream& out, Text text);
+
+    template <size_t Size>
+    constexpr Text text(const char (&literal)[Size])
+    {
+        return Text{ literal, Size - 1u };
+    }
+
+    struct StateEntry
+    {
+        fep3::SystemAggregatedState _state;
+        Text _name;
+        /// name accepted by setSystemState and setParticipantState, empty if the state cannot be set
+        Text _input_name;
+        /// the compact code as decimal text, used in snapshots
+        Text _code;
+        /// "<code> - <name>" as printed by the state commands
+        Text _line;
+    };
+
+    /// indexed by the value of the state, which is also its compact code
+    constexpr StateEntry states[] = {
+        { fep3::SystemAggregatedState::undefined, text("undefined"), text(""), text("0"), text("0 - undefined") },
+        { fep3::SystemAggregatedState::unreachable, text("unreachable"), text("shutdowned"), text("1"), text("1 - unreachable") },
+        { fep3::SystemAggregatedState::unloaded, text("unloaded"), text("unloaded"), text("2"), text("2 - unloaded") },
+        { fep3::SystemAggregatedState::loaded, text("loaded"), text("loaded"), text("3"), text("3 - loaded") },
+        { fep3::SystemAggregatedState::initialized, text("initialized"), text("initialized"), text("4"), text("4 - initialized") },
+        { fep3::SystemAggregatedState::paused, text("paused"), text("paused"), text("5"), text("5 - paused") },
+        { fep3::SystemAggregatedState::running, text("running"), text("running"), text("6"), text("6 - running") }
+    };
+    constexpr size_t state_count = sizeof(states) / sizeof(states[0]);
+
+    /// input names are hashed by first character and length, the buckets are checked to be unique at compile time
+    constexpr size_t name_bucket_count = 16u;
+    constexpr uint8_t no_entry = 0xFFu;
+
+    constexpr size_t hashName(const char* data, size_t size)
+    {
+        return size == 0u ? 0u : (static_cast<unsigned char>(data[0]) + size * 2u) % name_bucket_count;
+    }
+
+    struct NameIndex
+    {
+        uint8_t _entries[name_bucket_count];
+        bool _unique;
+    };
+
+    constexpr NameIndex buildNameIndex()
+    {
+        NameIndex index{ {}, true };
+        for (size_t bucket = 0u; bucket < name_bucket_count; ++bucket)
+        {
+            index._entries[bucket] = no_entry;
+        }
+        for (size_t entry = 0u; entry < state_count; ++entry)
+        {
+            const auto& name = states[entry]._input_name;
+            if (name._size == 0u)
+            {
+                continue;
+            }
+            const auto bucket = hashName(name._data, name._size);
+            index._unique = index._unique && index._entries[bucket] == no_entry;
+            index._entries[bucket] = static_cast<uint8_t>(entry);
+        }
+        return index;
+    }
+
+    constexpr NameIndex name_index = buildNameIndex();
+
+    constexpr bool isIndexedByValue()
+    {
+        for (size_t entry = 0u; entry < state_count; ++entry)
+        {
+            if (static_cast<size_t>(states[entry]._state) != entry)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static_assert(isIndexedByValue(), "the states have to be ordered by their value");
+    static_assert(name_index._unique, "the input names need distinct buckets, adapt hashName");
+    static_assert(state_count <= no_entry, "the compact code has to fit into one byte");
+
+    /// the entry of @p state, nullptr for values outside of the table
+    constexpr const StateEntry* find(fep3::SystemAggregatedState state)
+    {
+        return static_cast<size_t>(state) < state_count ? &states[static_cast<size_t>(state)] : nullptr;
+    }
+
+    /// the state with the given input name (one hash and one comparison), nullptr if there is none
+    const StateEntry* findByInputName(const std::string& name);
+
+    /// the name of @p state or "NOT RESOLVABLE"
+    Text getName(fep3::SystemAggregatedState state);
+
+    /// writes "<code> - <name>" of @p state
+    void writeLine(std::ostream& out, fep3::SystemAggregatedState state);
+
+    /// writes the compact code of @p state as decimal text
+    void writeCode(std::ostream& out, fep3::SystemAggregatedState state);
+}
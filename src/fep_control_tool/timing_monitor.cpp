@@ -0,0 +1,217 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "timing_monitor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include "worker_pool.h"
+
+namespace
+{
+    std::string toFixed(double value, int precision)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(precision) << value;
+        return out.str();
+    }
+
+    double toSeconds(int64_t nanoseconds)
+    {
+        return static_cast<double>(nanoseconds) / 1e9;
+    }
+
+    const timing_monitor::Sample* findValid(const std::vector<timing_monitor::Sample>& samples, const std::string& name)
+    {
+        for (const auto& sample : samples)
+        {
+            if (sample._name == name && sample._error.empty())
+            {
+                return &sample;
+            }
+        }
+        return nullptr;
+    }
+}
+
+double timing_monitor::getSkew(const Sample& sample, const Sample& master, double ratio)
+{
+    const double wall_offset = static_cast<double>(toNanoseconds(sample._wall_time - master._wall_time));
+    return static_cast<double>(sample._simulation_time - master._simulation_time) - ratio * wall_offset;
+}
+
+void timing_monitor::RunningStatistics::add(double value)
+{
+    ++_count;
+    const double delta = value - _mean;
+    _mean += delta / static_cast<double>(_count);
+    _squared_deviations += delta * (value - _mean);
+    _max_magnitude = std::max(_max_magnitude, std::abs(value));
+}
+
+uint64_t timing_monitor::RunningStatistics::getCount() const
+{
+    return _count;
+}
+
+double timing_monitor::RunningStatistics::getMean() const
+{
+    return _mean;
+}
+
+double timing_monitor::RunningStatistics::getStandardDeviation() const
+{
+    return _count < 2u ? 0.0 : std::sqrt(_squared_deviations / static_cast<double>(_count - 1u));
+}
+
+double timing_monitor::RunningStatistics::getMaxMagnitude() const
+{
+    return _max_magnitude;
+}
+
+timing_monitor::Sampler::Sampler(fep3::System& system,
+                                 rpc_proxy_cache::ProxyCache& proxies,
+                                 std::vector<std::string> participant_names)
+    : _system(system)
+    , _proxies(proxies)
+    , _participant_names(std::move(participant_names))
+    , _main_clocks(_participant_names.size())
+{
+}
+
+std::vector<timing_monitor::Sample> timing_monitor::Sampler::sample(size_t concurrency)
+{
+    std::vector<Sample> samples(_participant_names.size());
+    worker_pool::parallelFor(samples.size(), concurrency,
+        [&](size_t index)
+        {
+            auto& sample = samples[index];
+            sample._name = _participant_names[index];
+            try
+            {
+                auto clock = _proxies.getComponent<fep3::rpc::IRPCClockService>(_system, sample._name);
+                if (!clock)
+                {
+                    sample._error = "participant has no clock service";
+                    return;
+                }
+                if (_main_clocks[index].empty())
+                {
+                    _main_clocks[index] = clock->getMainClockName();
+                }
+                const auto begin = std::chrono::steady_clock::now();
+                sample._simulation_time = toNanoseconds(clock->getTime(_main_clocks[index]));
+                const auto end = std::chrono::steady_clock::now();
+                sample._wall_time = begin + (end - begin) / 2;
+            }
+            catch (const std::exception& e)
+            {
+                sample._error = e.what();
+                _main_clocks[index].clear();
+                _proxies.invalidate(sample._name);
+            }
+        });
+    return samples;
+}
+
+timing_monitor::TimingMonitor::TimingMonitor(std::string master_name)
+    : _master_name(std::move(master_name))
+{
+}
+
+void timing_monitor::TimingMonitor::addRound(const std::vector<Sample>& samples, std::ostream& out)
+{
+    ++_rounds;
+    for (const auto& sample : samples)
+    {
+        auto& statistics = _statistics[sample._name];
+        if (!sample._error.empty())
+        {
+            ++statistics._failed;
+            _previous.erase(sample._name);
+            continue;
+        }
+        const auto previous = _previous.find(sample._name);
+        if (previous != _previous.end())
+        {
+            const auto wall_time = toNanoseconds(sample._wall_time - previous->second._wall_time);
+            if (wall_time > 0)
+            {
+                statistics._ratios.add(static_cast<double>(sample._simulation_time - previous->second._simulation_time)
+                    / static_cast<double>(wall_time));
+            }
+        }
+        _previous[sample._name] = sample;
+    }
+
+    const auto master = findValid(samples, _master_name);
+    out << "round " << _rounds;
+    if (!master)
+    {
+        out << (_master_name.empty() ? ": no timing master" : ": no sample of the timing master") << std::endl;
+        return;
+    }
+    const auto& master_ratios = _statistics[_master_name]._ratios;
+    // before the second round the master is assumed to run in real time
+    const double ratio = master_ratios.getCount() == 0u ? 1.0 : master_ratios.getMean();
+    double max_skew = 0.0;
+    std::string max_skew_name;
+    for (const auto& sample : samples)
+    {
+        if (!sample._error.empty() || sample._name == _master_name)
+        {
+            continue;
+        }
+        const double skew = getSkew(sample, *master, ratio) / 1e6;
+        _statistics[sample._name]._skews.add(skew);
+        if (max_skew_name.empty() || std::abs(skew) > std::abs(max_skew))
+        {
+            max_skew = skew;
+            max_skew_name = sample._name;
+        }
+    }
+    out << ": master " << toFixed(toSeconds(master->_simulation_time), 3) << " s, ratio "
+        << (master_ratios.getCount() == 0u ? std::string("-") : toFixed(master_ratios.getMean(), 3));
+    if (!max_skew_name.empty())
+    {
+        out << ", max skew " << toFixed(max_skew, 3) << " ms (" << max_skew_name << ")";
+    }
+    out << std::endl;
+}
+
+void timing_monitor::TimingMonitor::printSummary(std::ostream& out) const
+{
+    out << "participant samples failed ratio jitter mean_skew[ms] max_abs_skew[ms]" << std::endl;
+    for (const auto& entry : _statistics)
+    {
+        const auto& statistics = entry.second;
+        const bool is_master = entry.first == _master_name;
+        out << entry.first << (is_master ? "(master)" : "") << " "
+            << (_rounds - statistics._failed) << " "
+            << statistics._failed << " "
+            << (statistics._ratios.getCount() == 0u ? std::string("-") : toFixed(statistics._ratios.getMean(), 3)) << " "
+            << (statistics._ratios.getCount() == 0u ? std::string("-") : toFixed(statistics._ratios.getStandardDeviation(), 3)) << " "
+            << (statistics._skews.getCount() == 0u ? std::string("-") : toFixed(statistics._skews.getMean(), 3)) << " "
+            << (statistics._skews.getCount() == 0u ? std::string("-") : toFixed(statistics._skews.getMaxMagnitude(), 3)) << std::endl;
+    }
+}
@@ -0,0 +1,132 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+
+namespace timing_monitor
+{
+    /// simulation times are compared in integral nanoseconds, whatever type the clock service returns
+    template <typename Rep, typename Period>
+    int64_t toNanoseconds(std::chrono::duration<Rep, Period> value)
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(value).count();
+    }
+
+    inline int64_t toNanoseconds(int64_t value)
+    {
+        return value;
+    }
+
+    struct Sample
+    {
+        std::string _name;
+        /// simulation time of the main clock of the participant
+        int64_t _simulation_time = 0;
+        /// midpoint of the round trip of the getTime call
+        std::chrono::steady_clock::time_point _wall_time;
+        /// set if the participant could not be sampled
+        std::string _error;
+    };
+
+    /**
+     * Simulation time of @p sample minus the one of @p master in ns, corrected by the wall time
+     * between both samples times the simulation time @p ratio of the master.
+     */
+    double getSkew(const Sample& sample, const Sample& master, double ratio);
+
+    /// count, mean, standard deviation and maximum magnitude of a series (Welford's algorithm)
+    class RunningStatistics
+    {
+    public:
+        void add(double value);
+
+        uint64_t getCount() const;
+        double getMean() const;
+        double getStandardDeviation() const;
+        double getMaxMagnitude() const;
+
+    private:
+        uint64_t _count = 0u;
+        double _mean = 0.0;
+        double _squared_deviations = 0.0;
+        double _max_magnitude = 0.0;
+    };
+
+    /**
+     * Samples the main clocks of the given participants via their clock service RPC component,
+     * querying at most @p concurrency participants at the same time.
+     * The name of the main clock of each participant is looked up once, by the first sample.
+     * A failing participant gets an error in its sample and its cached proxies are invalidated.
+     */
+    class Sampler
+    {
+    public:
+        Sampler(fep3::System& system, rpc_proxy_cache::ProxyCache& proxies, std::vector<std::string> participant_names);
+
+        std::vector<Sample> sample(size_t concurrency);
+
+    private:
+        fep3::System& _system;
+        rpc_proxy_cache::ProxyCache& _proxies;
+        std::vector<std::string> _participant_names;
+        /// index aligned with _participant_names, empty until looked up
+        std::vector<std::string> _main_clocks;
+    };
+
+    /**
+     * Evaluates consecutive rounds of samples.
+     * The skew of a participant is measured against @p master_name with the achieved ratio of the master.
+     * The ratio of a participant is the simulation time divided by the wall time between two rounds,
+     * its jitter is the standard deviation of these ratios.
+     */
+    class TimingMonitor
+    {
+    public:
+        explicit TimingMonitor(std::string master_name);
+
+        /// adds one round and prints one line with the master time, its ratio and the largest skew
+        void addRound(const std::vector<Sample>& samples, std::ostream& out);
+        /// prints one line with ratio, jitter and skew per participant
+        void printSummary(std::ostream& out) const;
+
+    private:
+        struct ParticipantStatistics
+        {
+            RunningStatistics _ratios;
+            /// in ms
+            RunningStatistics _skews;
+            uint64_t _failed = 0u;
+        };
+
+        std::string _master_name;
+        size_t _rounds = 0u;
+        std::map<std::string, Sample> _previous;
+        std::map<std::string, ParticipantStatistics> _statistics;
+    };
+}
@@ -0,0 +1,199 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "timing_preflight.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+
+#include "worker_pool.h"
+
+namespace
+{
+    const std::string clock_sync_master_component = "clock_sync_master";
+    const std::string discrete_clock = "local_system_simtime";
+    const std::string slave_clock = "slave_master_on_demand";
+    const std::string discrete_slave_clock = "slave_master_on_demand_discrete";
+
+    bool isSlaveClock(const std::string& clock)
+    {
+        return clock == slave_clock || clock == discrete_slave_clock;
+    }
+
+    bool parseStepSize(const std::string& value, long long& step_size)
+    {
+        char* end = nullptr;
+        step_size = std::strtoll(value.c_str(), &end, 10);
+        return !value.empty() && *end == '\0';
+    }
+
+    bool parseFactor(const std::string& value, double& factor)
+    {
+        char* end = nullptr;
+        factor = std::strtod(value.c_str(), &end);
+        return !value.empty() && *end == '\0';
+    }
+
+    std::string readProperty(const std::shared_ptr<fep3::IProperties>& node, const std::string& name)
+    {
+        return node ? node->getProperty(name) : std::string();
+    }
+
+    void readParticipant(fep3::System& system,
+                         rpc_proxy_cache::ProxyCache& proxies,
+                         timing_preflight::ParticipantTiming& timing)
+    {
+        try
+        {
+            auto configuration = proxies.getComponent<fep3::rpc::IRPCConfiguration>(system, timing._name);
+            auto info = proxies.getComponent<fep3::rpc::IRPCParticipantInfo>(system, timing._name);
+            if (!configuration || !info)
+            {
+                timing._error = "participant has no RPC Configuration or RPC Info";
+                return;
+            }
+            const auto clock = configuration->getProperties("clock");
+            timing._main_clock = readProperty(clock, "main_clock");
+            timing._step_size = readProperty(clock, "step_size");
+            timing._time_factor = readProperty(clock, "time_factor");
+            timing._timing_master = readProperty(configuration->getProperties("clock_synchronization"), "timing_master");
+            const auto components = info->getRPCComponents();
+            timing._has_clock_sync_master =
+                std::find(components.begin(), components.end(), clock_sync_master_component) != components.end();
+        }
+        catch (const std::exception& e)
+        {
+            timing._error = e.what();
+            proxies.invalidate(timing._name);
+        }
+    }
+
+    void checkDiscreteClock(const timing_preflight::ParticipantTiming& timing,
+                            const timing_preflight::ParticipantTiming* master,
+                            std::vector<std::string>& problems)
+    {
+        long long step_size = 0;
+        double factor = 0.0;
+        if (!parseStepSize(timing._step_size, step_size) || step_size <= 0)
+        {
+            problems.push_back("participant \"" + timing._name + "\" has the invalid step size \"" + timing._step_size + "\"");
+        }
+        else if (master && master != &timing && master->_main_clock == discrete_clock && timing._step_size != master->_step_size)
+        {
+            problems.push_back("participant \"" + timing._name + "\" has the step size " + timing._step_size
+                + " but the timing master has " + master->_step_size);
+        }
+        if (!parseFactor(timing._time_factor, factor) || factor < 0.0)
+        {
+            problems.push_back("participant \"" + timing._name + "\" has the invalid time factor \"" + timing._time_factor + "\"");
+        }
+    }
+}
+
+std::vector<timing_preflight::ParticipantTiming> timing_preflight::read(fep3::System& system,
+                                                                        rpc_proxy_cache::ProxyCache& proxies,
+                                                                        const std::vector<std::string>& participant_names,
+                                                                        size_t concurrency)
+{
+    std::vector<ParticipantTiming> participants(participant_names.size());
+    for (size_t index = 0u; index < participant_names.size(); ++index)
+    {
+        participants[index]._name = participant_names[index];
+    }
+    worker_pool::parallelFor(participants.size(), concurrency,
+        [&](size_t index)
+        {
+            readParticipant(system, proxies, participants[index]);
+        });
+    return participants;
+}
+
+std::vector<std::string> timing_preflight::check(const std::vector<ParticipantTiming>& participants)
+{
+    std::vector<std::string> problems;
+    // timing master -> participants naming it
+    std::map<std::string, std::vector<std::string>> masters;
+    for (const auto& timing : participants)
+    {
+        if (!timing._error.empty())
+        {
+            problems.push_back("cannot read the timing configuration of participant \"" + timing._name + "\", error: " + timing._error);
+        }
+        else if (!timing._timing_master.empty())
+        {
+            masters[timing._timing_master].push_back(timing._name);
+        }
+    }
+    if (masters.size() > 1u)
+    {
+        std::string naming;
+        for (const auto& master : masters)
+        {
+            naming += (naming.empty() ? "" : ", ") + master.first + " (" + std::to_string(master.second.size()) + " participants)";
+        }
+        problems.push_back("participants name different timing masters: " + naming);
+    }
+
+    const ParticipantTiming* master = nullptr;
+    if (masters.size() == 1u)
+    {
+        const auto& master_name = masters.begin()->first;
+        const auto found = std::find_if(participants.begin(), participants.end(),
+            [&master_name](const ParticipantTiming& timing)
+            {
+                return timing._name == master_name;
+            });
+        if (found == participants.end())
+        {
+            problems.push_back("timing master \"" + master_name + "\" is not in the system");
+        }
+        else if (found->_error.empty())
+        {
+            master = &*found;
+            if (!master->_has_clock_sync_master)
+            {
+                problems.push_back("timing master \"" + master_name + "\" has no RPC component \"" + clock_sync_master_component + "\"");
+            }
+            if (isSlaveClock(master->_main_clock))
+            {
+                problems.push_back("timing master \"" + master_name + "\" uses the slave clock \"" + master->_main_clock + "\"");
+            }
+        }
+    }
+
+    for (const auto& timing : participants)
+    {
+        if (!timing._error.empty())
+        {
+            continue;
+        }
+        if (isSlaveClock(timing._main_clock) && timing._timing_master.empty())
+        {
+            problems.push_back("participant \"" + timing._name + "\" uses the slave clock \"" + timing._main_clock + "\" without timing master");
+        }
+        // slave clocks get their steps from the master, only own discrete clocks use step size and factor
+        if (timing._main_clock == discrete_clock)
+        {
+            checkDiscreteClock(timing, master, problems);
+        }
+    }
+    return problems;
+}
@@ -0,0 +1,66 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+
+namespace timing_preflight
+{
+    /// the timing relevant properties of one participant, empty if not set
+    struct ParticipantTiming
+    {
+        std::string _name;
+        /// clock/main_clock
+        std::string _main_clock;
+        /// clock/step_size in ns
+        std::string _step_size;
+        /// clock/time_factor
+        std::string _time_factor;
+        /// clock_synchronization/timing_master
+        std::string _timing_master;
+        /// whether the participant exposes the RPC component "clock_sync_master"
+        bool _has_clock_sync_master = false;
+        /// set if the participant could not be queried
+        std::string _error;
+    };
+
+    /**
+     * Reads the timing properties and the RPC components of each of @p participant_names,
+     * at most @p concurrency participants at the same time.
+     * The cached proxies of participants that could not be reached are invalidated.
+     */
+    std::vector<ParticipantTiming> read(fep3::System& system,
+                                        rpc_proxy_cache::ProxyCache& proxies,
+                                        const std::vector<std::string>& participant_names,
+                                        size_t concurrency);
+
+    /**
+     * Returns one message per problem, empty if the timing configuration can be started:
+     * all participants name the same timing master, which is in the system, exposes "clock_sync_master"
+     * and does not use a slave clock, slave clocks have a master, and every local discrete clock has a positive
+     * step size equal to the one of the master and a non negative time factor.
+     * Without any timing master only the slave clocks are checked.
+     */
+    std::vector<std::string> check(const std::vector<ParticipantTiming>& participants);
+}
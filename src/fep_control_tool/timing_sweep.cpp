@@ -0,0 +1,158 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+
+#include "timing_sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "timing_monitor.h"
+
+namespace
+{
+    std::string toFixed(double value, int precision)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(precision) << value;
+        return out.str();
+    }
+
+    const timing_monitor::Sample& findMaster(const std::vector<timing_monitor::Sample>& samples, const std::string& master_name)
+    {
+        const auto master = std::find_if(samples.begin(), samples.end(),
+            [&master_name](const timing_monitor::Sample& sample)
+            {
+                return sample._name == master_name;
+            });
+        if (master == samples.end())
+        {
+            throw std::runtime_error("master \"" + master_name + "\" is not in the system");
+        }
+        if (!master->_error.empty())
+        {
+            throw std::runtime_error("cannot sample master \"" + master_name + "\", error: " + master->_error);
+        }
+        return *master;
+    }
+
+    void measure(fep3::System& system,
+                 rpc_proxy_cache::ProxyCache& proxies,
+                 const std::string& master_name,
+                 std::chrono::milliseconds duration,
+                 size_t concurrency,
+                 timing_sweep::Result& result)
+    {
+        std::vector<std::string> participant_names;
+        for (const auto& participant : system.getParticipants())
+        {
+            participant_names.push_back(participant.getName());
+        }
+        timing_monitor::Sampler sampler(system, proxies, std::move(participant_names));
+
+        system.configureTiming3DiscreteSteps(master_name, result._combination._step_size, result._combination._factor);
+        system.initialize();
+        system.start();
+        const auto first = sampler.sample(concurrency);
+        std::this_thread::sleep_for(duration);
+        const auto last = sampler.sample(concurrency);
+        system.stop();
+        system.deinitialize();
+
+        const auto& first_master = findMaster(first, master_name);
+        const auto& last_master = findMaster(last, master_name);
+        result._simulation_time = last_master._simulation_time - first_master._simulation_time;
+        result._wall_time = last_master._wall_time - first_master._wall_time;
+        const auto wall_time = timing_monitor::toNanoseconds(result._wall_time);
+        result._throughput = wall_time > 0 ? static_cast<double>(result._simulation_time) / static_cast<double>(wall_time) : 0.0;
+        for (const auto& sample : last)
+        {
+            if (sample._error.empty() && sample._name != master_name)
+            {
+                result._drift = std::max(result._drift,
+                    std::abs(timing_monitor::getSkew(sample, last_master, result._throughput)) / 1e6);
+            }
+        }
+    }
+}
+
+std::vector<timing_sweep::Combination> timing_sweep::combine(const std::vector<std::string>& step_sizes,
+                                                             const std::vector<std::string>& factors)
+{
+    std::vector<Combination> combinations;
+    combinations.reserve(step_sizes.size() * factors.size());
+    for (const auto& step_size : step_sizes)
+    {
+        for (const auto& factor : factors)
+        {
+            combinations.push_back({ step_size, factor });
+        }
+    }
+    return combinations;
+}
+
+timing_sweep::Result timing_sweep::run(fep3::System& system,
+                                       rpc_proxy_cache::ProxyCache& proxies,
+                                       const std::string& master_name,
+                                       const Combination& combination,
+                                       std::chrono::milliseconds duration,
+                                       size_t concurrency)
+{
+    Result result;
+    result._combination = combination;
+    try
+    {
+        measure(system, proxies, master_name, duration, concurrency, result);
+    }
+    catch (const std::exception& e)
+    {
+        result._error = e.what();
+        try
+        {
+            system.setSystemState(fep3::SystemAggregatedState::loaded);
+        }
+        catch (const std::exception& reset_error)
+        {
+            result._error += ", cannot set the system back to loaded, error: " + std::string(reset_error.what());
+        }
+    }
+    return result;
+}
+
+void timing_sweep::print(std::ostream& out, const std::vector<Result>& results)
+{
+    out << "step_size[ns] factor sim_time[s] wall_time[s] throughput drift[ms]" << std::endl;
+    for (const auto& result : results)
+    {
+        out << result._combination._step_size << " " << result._combination._factor << " ";
+        if (!result._error.empty())
+        {
+            out << "- - - -" << std::endl;
+            continue;
+        }
+        out << toFixed(static_cast<double>(result._simulation_time) / 1e9, 3) << " "
+            << toFixed(std::chrono::duration<double>(result._wall_time).count(), 3) << " "
+            << toFixed(result._throughput, 3) << " "
+            << toFixed(result._drift, 3) << std::endl;
+    }
+}
@@ -0,0 +1,71 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <fep_system/fep_system.h>
+
+#include "rpc_proxy_cache.h"
+
+namespace timing_sweep
+{
+    struct Combination
+    {
+        /// in ns, like the step size of configureTiming3DiscreteSteps
+        std::string _step_size;
+        std::string _factor;
+    };
+
+    struct Result
+    {
+        Combination _combination;
+        /// simulation time of the master between the first and the last sample in ns
+        int64_t _simulation_time = 0;
+        std::chrono::steady_clock::duration _wall_time{};
+        /// simulated seconds per wall second
+        double _throughput = 0.0;
+        /// largest absolute skew of a participant to the master at the end of the run in ms
+        double _drift = 0.0;
+        /// set if the combination could not be measured
+        std::string _error;
+    };
+
+    /// all combinations of @p step_sizes and @p factors, step sizes varying slowest
+    std::vector<Combination> combine(const std::vector<std::string>& step_sizes, const std::vector<std::string>& factors);
+
+    /**
+     * Configures Discrete Time with @p master_name and the given combination on the loaded @p system,
+     * initializes and starts it, samples the main clocks of all participants right after the start
+     * and after @p duration, then stops and deinitializes it again.
+     * On errors the system is set back to loaded and the error is returned in the result.
+     */
+    Result run(fep3::System& system,
+               rpc_proxy_cache::ProxyCache& proxies,
+               const std::string& master_name,
+               const Combination& combination,
+               std::chrono::milliseconds duration,
+               size_t concurrency);
+
+    /// prints one line with simulated time, wall time, throughput and drift per combination
+    void print(std::ostream& out, const std::vector<Result>& results);
+}
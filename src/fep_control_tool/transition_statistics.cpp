@@ -0,0 +1,239 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+
+#include "transition_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    // values below 2^linear_bits are stored exactly, above that every power of two
+    // is split into 2^(linear_bits - 1) sub buckets
+    constexpr uint64_t linear_bits = 7u;
+    constexpr uint64_t linear_count = uint64_t(1) << linear_bits;
+    constexpr uint64_t sub_bucket_count = linear_count / 2u;
+
+    size_t mostSignificantBit(uint64_t value)
+    {
+        size_t msb = 0u;
+        while (value >>= 1u)
+        {
+            ++msb;
+        }
+        return msb;
+    }
+
+    std::string toMilliseconds(std::chrono::microseconds value)
+    {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(3) << value.count() / 1000.0;
+        return out.str();
+    }
+
+    std::string participantColumn(const std::string& participant_name)
+    {
+        return participant_name.empty() ? "*" : participant_name;
+    }
+}
+
+size_t transition_statistics::LatencyHistogram::indexOf(uint64_t value)
+{
+    if (value < linear_count)
+    {
+        return static_cast<size_t>(value);
+    }
+    const size_t msb = mostSignificantBit(value);
+    const uint64_t top = value >> (msb - (linear_bits - 1u));
+    return static_cast<size_t>(linear_count + (msb - linear_bits) * sub_bucket_count + (top - sub_bucket_count));
+}
+
+uint64_t transition_statistics::LatencyHistogram::highestEquivalentValue(size_t index)
+{
+    if (index < linear_count)
+    {
+        return index;
+    }
+    const uint64_t msb = linear_bits + (index - linear_count) / sub_bucket_count;
+    const uint64_t top = sub_bucket_count + (index - linear_count) % sub_bucket_count;
+    const uint64_t shift = msb - (linear_bits - 1u);
+    return (top << shift) + ((uint64_t(1) << shift) - 1u);
+}
+
+void transition_statistics::LatencyHistogram::record(std::chrono::microseconds duration)
+{
+    const uint64_t value = duration.count() < 0 ? 0u : static_cast<uint64_t>(duration.count());
+    const size_t index = indexOf(value);
+    if (index >= _buckets.size())
+    {
+        _buckets.resize(index + 1u, 0u);
+    }
+    ++_buckets[index];
+    ++_count;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+}
+
+void transition_statistics::LatencyHistogram::recordFailure()
+{
+    ++_failed;
+}
+
+uint64_t transition_statistics::LatencyHistogram::getCount() const
+{
+    return _count;
+}
+
+uint64_t transition_statistics::LatencyHistogram::getFailedCount() const
+{
+    return _failed;
+}
+
+std::chrono::microseconds transition_statistics::LatencyHistogram::getMin() const
+{
+    return std::chrono::microseconds(_count == 0u ? 0u : _min);
+}
+
+std::chrono::microseconds transition_statistics::LatencyHistogram::getMax() const
+{
+    return std::chrono::microseconds(_max);
+}
+
+std::chrono::microseconds transition_statistics::LatencyHistogram::getMean() const
+{
+    return std::chrono::microseconds(_count == 0u ? 0u : _sum / _count);
+}
+
+std::chrono::microseconds transition_statistics::LatencyHistogram::getPercentile(double percentile) const
+{
+    if (_count == 0u)
+    {
+        return std::chrono::microseconds(0);
+    }
+    percentile = std::min(std::max(percentile, 0.0), 100.0);
+    const uint64_t rank = std::max<uint64_t>(1u,
+        static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(_count))));
+    uint64_t accumulated = 0u;
+    for (size_t index = 0u; index < _buckets.size(); ++index)
+    {
+        accumulated += _buckets[index];
+        if (accumulated >= rank)
+        {
+            return std::chrono::microseconds(std::min(highestEquivalentValue(index), _max));
+        }
+    }
+    return getMax();
+}
+
+transition_statistics::TransitionStatistics::Key transition_statistics::TransitionStatistics::makeKey(
+    const std::string& system_name,
+    const std::string& participant_name,
+    const std::string& transition)
+{
+    auto& symbols = symbol_table::getSymbols();
+    return Key(symbols.intern(system_name), symbols.intern(participant_name), symbols.intern(transition));
+}
+
+std::vector<transition_statistics::TransitionStatistics::NamedEntry> transition_statistics::TransitionStatistics::getSortedEntries() const
+{
+    const auto& symbols = symbol_table::getSymbols();
+    std::vector<NamedEntry> entries;
+    entries.reserve(_histograms.size());
+    for (const auto& entry : _histograms)
+    {
+        entries.emplace_back(std::make_tuple(symbols.getName(std::get<0>(entry.first)),
+                                             symbols.getName(std::get<1>(entry.first)),
+                                             symbols.getName(std::get<2>(entry.first))),
+                             &entry.second);
+    }
+    std::sort(entries.begin(), entries.end(),
+        [](const NamedEntry& lhs, const NamedEntry& rhs)
+        {
+            return lhs.first < rhs.first;
+        });
+    return entries;
+}
+
+void transition_statistics::TransitionStatistics::record(const std::string& system_name,
+                                                         const std::string& participant_name,
+                                                         const std::string& transition,
+                                                         std::chrono::microseconds duration)
+{
+    const auto key = makeKey(system_name, participant_name, transition);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _histograms[key].record(duration);
+}
+
+void transition_statistics::TransitionStatistics::recordFailure(const std::string& system_name,
+                                                                const std::string& participant_name,
+                                                                const std::string& transition)
+{
+    const auto key = makeKey(system_name, participant_name, transition);
+    std::lock_guard<std::mutex> lock(_mutex);
+    _histograms[key].recordFailure();
+}
+
+bool transition_statistics::TransitionStatistics::empty() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _histograms.empty();
+}
+
+void transition_statistics::TransitionStatistics::dump(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    out << "system participant transition count failed p50[ms] p95[ms] p99[ms] max[ms]" << std::endl;
+    for (const auto& entry : getSortedEntries())
+    {
+        const auto& histogram = *entry.second;
+        out << std::get<0>(entry.first) << " "
+            << participantColumn(std::get<1>(entry.first)) << " "
+            << std::get<2>(entry.first) << " "
+            << histogram.getCount() << " "
+            << histogram.getFailedCount() << " "
+            << toMilliseconds(histogram.getPercentile(50.0)) << " "
+            << toMilliseconds(histogram.getPercentile(95.0)) << " "
+            << toMilliseconds(histogram.getPercentile(99.0)) << " "
+            << toMilliseconds(histogram.getMax()) << std::endl;
+    }
+}
+
+void transition_statistics::TransitionStatistics::writeCsv(std::ostream& out) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    out << "system,participant,transition,count,failed,min_us,mean_us,p50_us,p95_us,p99_us,max_us\n";
+    for (const auto& entry : getSortedEntries())
+    {
+        const auto& histogram = *entry.second;
+        out << std::get<0>(entry.first) << ","
+            << participantColumn(std::get<1>(entry.first)) << ","
+            << std::get<2>(entry.first) << ","
+            << histogram.getCount() << ","
+            << histogram.getFailedCount() << ","
+            << histogram.getMin().count() << ","
+            << histogram.getMean().count() << ","
+            << histogram.getPercentile(50.0).count() << ","
+            << histogram.getPercentile(95.0).count() << ","
+            << histogram.getPercentile(99.0).count() << ","
+            << histogram.getMax().count() << "\n";
+    }
+}
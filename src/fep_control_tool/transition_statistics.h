@@ -0,0 +1,125 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "symbol_table.h"
+
+namespace transition_statistics
+{
+    /**
+     * Log-linear latency histogram in the style of HdrHistogram.
+     * Values are recorded in microseconds, exact up to 127 us and with a relative
+     * error below 1/64 above that. Buckets are allocated lazily up to the highest recorded value.
+     */
+    class LatencyHistogram
+    {
+    public:
+        void record(std::chrono::microseconds duration);
+        void recordFailure();
+
+        uint64_t getCount() const;
+        uint64_t getFailedCount() const;
+        std::chrono::microseconds getMin() const;
+        std::chrono::microseconds getMax() const;
+        std::chrono::microseconds getMean() const;
+        /// @p percentile in the range [0.0, 100.0], returns the highest value equivalent to the bucket
+        std::chrono::microseconds getPercentile(double percentile) const;
+
+    private:
+        static size_t indexOf(uint64_t value);
+        static uint64_t highestEquivalentValue(size_t index);
+
+        std::vector<uint64_t> _buckets;
+        uint64_t _count = 0u;
+        uint64_t _failed = 0u;
+        uint64_t _sum = 0u;
+        uint64_t _min = UINT64_MAX;
+        uint64_t _max = 0u;
+    };
+
+    /**
+     * Session wide latency histograms keyed by the interned (system, participant, transition).
+     * System wide transitions are recorded with an empty participant name.
+     * All methods are thread safe.
+     */
+    class TransitionStatistics
+    {
+    public:
+        typedef std::tuple<symbol_table::SymbolId, symbol_table::SymbolId, symbol_table::SymbolId> Key;
+
+        void record(const std::string& system_name,
+                    const std::string& participant_name,
+                    const std::string& transition,
+                    std::chrono::microseconds duration);
+        void recordFailure(const std::string& system_name,
+                           const std::string& participant_name,
+                           const std::string& transition);
+
+        bool empty() const;
+        /// prints one line with count, p50, p95, p99 and max (in ms) per key
+        void dump(std::ostream& out) const;
+        void writeCsv(std::ostream& out) const;
+
+    private:
+        static Key makeKey(const std::string& system_name,
+                           const std::string& participant_name,
+                           const std::string& transition);
+        typedef std::pair<std::tuple<std::string, std::string, std::string>, const LatencyHistogram*> NamedEntry;
+        /// entries sorted by names, to be called with the lock held
+        std::vector<NamedEntry> getSortedEntries() const;
+
+        mutable std::mutex _mutex;
+        std::map<Key, LatencyHistogram> _histograms;
+    };
+
+    /**
+     * Measures the wall time of @p call, records it for the given key and returns it.
+     * Exceptions of @p call are recorded as failures and rethrown.
+     */
+    template <typename Callable>
+    std::chrono::microseconds measure(TransitionStatistics& statistics,
+                                      const std::string& system_name,
+                                      const std::string& participant_name,
+                                      const std::string& transition,
+                                      Callable&& call)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        try
+        {
+            call();
+        }
+        catch (...)
+        {
+            statistics.recordFailure(system_name, participant_name, transition);
+            throw;
+        }
+        const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        statistics.record(system_name, participant_name, transition, duration);
+        return duration;
+    }
+}
@@ -0,0 +1,32 @@
+/**
+* @file
+*
+* @copyright
+* @verbatim
+* Copyright @ 2020 AUDI AG. All rights reserved.
+*
+* This Source Code Form is subject to the terms of the Mozilla
+* Public License, v. 2.0. If a copy of the MPL was not distributed
+* with this file, You can obtain one at https://mozilla.org/MPL/2.0/.
+*
+* If it is not possible or desirable to put the notice in a particular file, then
+* You may include the notice in a location (such as a LICENSE file in a
+* relevant directory) where a recipient would be likely to look for such a notice.
+*
+* You may add additional accurate notices of copyright ownership.
+* @endverbatim
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace worker_pool
+{
+    /**
+     * Calls @p task for every index in [0, @p count) on at most @p concurrency worker threads
+     * and returns when all tasks are finished. The calling thread is one of the workers.
+     * If tasks throw, the first exception is rethrown after all workers have joined.
+     */
+    void parallelFor(size_t count, size_t concurrency, const std::function<void(size_t index)>& task);
+}
@@ -21,12 +21,18 @@
  *
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <ctime>
+#include <fstream>
 #include <unordered_set>
 #include <chrono>
 #include <thread>
 #include "gtest/gtest.h"
 #include <fep_system/fep_system.h>
 #include <boost/process.hpp>
+#include <boost/filesystem.hpp>
 #include <a_util/strings.h>
 #include <a_util/filesystem.h>
 #include "../../../../../src/fep_control_tool/control_tool_common_helper.h"
@@ -86,6 +92,41 @@ inline void checkUntilPrompt(bp::child& c, bp::ipstream& reader_stream, const st
     }
 }
 
+inline std::vector<std::string> readUntilPrompt(bp::child& c, bp::ipstream& reader_stream)
+{
+    std::vector<std::string> answer;
+    std::string str;
+    for (;;)
+    {
+        EXPECT_TRUE(c.running());
+        if (!c.running() || !(reader_stream >> str) || str == "fep>")
+        {
+            return answer;
+        }
+        if (!skippables.count(str))
+        {
+            answer.push_back(str);
+        }
+    }
+}
+
+/**
+* Reads answers over prompts until @p expected_tokens were printed, for commands whose answer
+* is mixed with output of background threads (which redraws the prompt).
+*/
+inline std::vector<std::string> readUntilPromptAfter(bp::child& c, bp::ipstream& reader_stream,
+    const std::vector<std::string>& expected_tokens)
+{
+    std::vector<std::string> answer;
+    while (c.running()
+        && std::search(answer.begin(), answer.end(), expected_tokens.begin(), expected_tokens.end()) == answer.end())
+    {
+        const auto part = readUntilPrompt(c, reader_stream);
+        answer.insert(answer.end(), part.begin(), part.end());
+    }
+    return answer;
+}
+
 inline void closeSession(bp::child& c, bp::opstream& writer_stream)
 {
     ASSERT_TRUE(c.running());
@@ -129,6 +170,7 @@ TEST(ControlTool, testHelp)
         "quit",
         "discoverAllSystems",
         "discoverSystem",
+        "discoverSystems",
         "setCurrentWorkingDirectory",
         "getCurrentWorkingDirectory",
         "connectSystem",
@@ -160,12 +202,39 @@ TEST(ControlTool, testHelp)
         "setParticipantState",
         "getParticipants",
         "configureSystem",
+        "getProperties",
+        "setProperties",
+        "saveConfiguration",
+        "restoreConfiguration",
+        "watchConfiguration",
+        "stopWatchingConfiguration",
         "configureTiming3SystemTime",
         "configureTiming3DiscreteTime",
         "configureTiming3NoSync",
         "getCurrentTimingMaster",
+        "snapshot",
+        "rpcCall",
+        "rpcBench",
+        "timingMonitor",
+        "timingSweep",
+        "timingPreflight",
+        "propertyCache",
+        "definitionCache",
+        "diffSnapshot",
+        "transitionStats",
+        "cycleSystem",
+        "jobs",
+        "wait",
+        "cancel",
+        "enableCanaryTransitions",
+        "disableCanaryTransitions",
+        "enableTimingPreflight",
+        "disableTimingPreflight",
         "enableAutoDiscovery",
         "disableAutoDiscovery",
+        "enableBackgroundDiscovery",
+        "disableBackgroundDiscovery",
+        "waitForParticipantChanges",
 	};
     std::vector<std::string> listed_commands;
 
@@ -251,6 +320,23 @@ struct TestElement : public fep3::core::ElementBase
     {
     }
 };
+/// fails the given number of initializations, for transitions failing in a valid state
+std::atomic<int> initialize_failures(0);
+struct FailingElement : public fep3::core::ElementBase
+{
+    FailingElement() : fep3::core::ElementBase("FailingElement", "3.0")
+    {
+    }
+    fep3::Result initialize() override
+    {
+        if (initialize_failures > 0)
+        {
+            --initialize_failures;
+            RETURN_ERROR_DESCRIPTION(fep3::ERR_FAILED, "initialization refused by the test");
+        }
+        return {};
+    }
+};
 struct PartStruct
 {
     PartStruct(PartStruct&&) = default;
@@ -441,6 +527,90 @@ TEST(ControlTool, testConfigureSystem)
     a_util::filesystem::setWorkingDirectory(current_path);
 }
 
+/**
+* @brief Test configureSystem in delta mode
+*/
+TEST(ControlTool, testConfigureSystemDelta)
+{
+    const auto current_path = a_util::filesystem::getWorkingDirectory();
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    const auto test_files_path = current_path + "files";
+    writer_stream << "setCurrentWorkingDirectory " << quoteFilenameIfNecessary(test_files_path.toString()) << std::endl;
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "connectSystem \"DEMO fep_sdk.system\"" << std::endl;
+    const std::vector<std::string> expected_answer_participants = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_participants);
+
+    //nothing applied yet, so the timing properties of the file are new
+    const std::vector<std::string> expected_answer_timing = { "timing", "properties", "changed", "properties", "set",
+        "0", "of", "0", "properties", "changed", "on", "0", "participants" };
+    writer_stream << "configureSystem FEP_SYSTEM DEMO.properties delta" << std::endl;
+    checkUntilPrompt(c, reader_stream, expected_answer_timing);
+
+    //DEMO.properties has no participant properties
+    const std::vector<std::string> expected_answer_unchanged = { "0", "of", "0", "properties", "changed", "on", "0", "participants" };
+    writer_stream << "configureSystem FEP_SYSTEM DEMO.properties delta" << std::endl;
+    checkUntilPrompt(c, reader_stream, expected_answer_unchanged);
+
+    //changing the timing by another command drops the baseline
+    writer_stream << "configureTiming3NoSync FEP_SYSTEM" << std::endl;
+    skipUntilPrompt(c, reader_stream);
+    writer_stream << "configureSystem FEP_SYSTEM DEMO.properties delta" << std::endl;
+    checkUntilPrompt(c, reader_stream, expected_answer_timing);
+
+    writer_stream << "configureSystem FEP_SYSTEM DEMO.properties partial" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "mode", "\"partial\",", "use", "full", "or", "delta" });
+
+    writer_stream << "configureSystem FEP_SYSTEM not_existing.properties delta" << std::endl;
+    const auto answer_missing = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer_missing.size(), 4u);
+    EXPECT_EQ(std::vector<std::string>(answer_missing.begin(), answer_missing.begin() + 4),
+        std::vector<std::string>({ "cannot", "read", "properties", "file" }));
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::setWorkingDirectory(current_path);
+}
+
+/**
+* @brief Test configureSystem with participant properties, set in parallel
+*/
+TEST(ControlTool, testConfigureSystemParticipantProperties)
+{
+    const auto current_path = a_util::filesystem::getWorkingDirectory();
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    const auto test_files_path = current_path + "files";
+    writer_stream << "setCurrentWorkingDirectory " << quoteFilenameIfNecessary(test_files_path.toString()) << std::endl;
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "connectSystem \"DEMO fep_sdk.system\"" << std::endl;
+    const std::vector<std::string> expected_answer_participants = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_participants);
+
+    writer_stream << "configureSystem FEP_SYSTEM DEMO_clock.properties" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "1", "of", "1", "properties", "set", "on", "1", "participants" });
+
+    writer_stream << "configureSystem FEP_SYSTEM DEMO_clock.properties delta" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "0", "of", "1", "properties", "changed", "on", "0", "participants" });
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::setWorkingDirectory(current_path);
+}
+
 /**
 * @brief Test discoverSystem
 */
@@ -461,6 +631,40 @@ TEST(ControlTool, testDiscoverSystem)
 	closeSession(c, writer_stream);
 }
 
+/**
+* @brief Test discoverSystems with several names and the variadic argument check
+*/
+TEST(ControlTool, testDiscoverSystems)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverSystems" << std::endl;
+    const std::vector<std::string> expected_answer_arguments = { "Invalid", "number", "of", "arguments", "for", "\"discoverSystems\"",
+        "(0", "instead", "of", "1", "or", "more),", "use", "\"help\"", "for", "more", "information" };
+    checkUntilPrompt(c, reader_stream, expected_answer_arguments);
+
+    writer_stream << "discoverSystems FEP_SYSTEM NOT_EXISTING" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1",
+        "system", "\"NOT_EXISTING\"", "was", "not", "found" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    const std::vector<std::string> expected_answer_state = { "6", "-", "running", "-", "homogeneous", ":", "1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_state);
+
+    writer_stream << "help discoverSystems" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "discoverSystems", "<system", "name>", "...", ":",
+        "discovers", "all", "given", "systems", "within", "one", "discovery" });
+
+    closeSession(c, writer_stream);
+}
+
 /**
 * @brief Test wrong command
 */
@@ -639,6 +843,48 @@ TEST(ControlTool, testParticipantStates)
     closeSession(c, writer_stream);
  }
 
+/**
+* @brief Test the state names accepted by setSystemState and setParticipantState
+*/
+TEST(ControlTool, testStateNames)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" });
+
+    const std::vector<std::pair<std::string, std::string>> settable = {
+        { "loaded", "3" }, { "unloaded", "2" }, { "loaded", "3" }, { "initialized", "4" },
+        { "running", "6" }, { "paused", "5" }, { "running", "6" }, { "initialized", "4" } };
+    for (const auto& state : settable)
+    {
+        writer_stream << "setSystemState FEP_SYSTEM " << state.first << std::endl;
+        checkUntilPrompt(c, reader_stream, { state.second, "-", state.first, "-", "homogeneous", ":", "1" });
+    }
+
+    //"runnimg" shares the hash bucket of "running", the display names "undefined" and "unreachable" cannot be set
+    for (const auto& name : { "runnimg", "run", "Running", "undefined", "unreachable" })
+    {
+        writer_stream << "setSystemState FEP_SYSTEM " << name << std::endl;
+        checkUntilPrompt(c, reader_stream, { "invalid", "state", "\"" + std::string(name) + "\",", "use",
+            "shutdowned,", "unloaded,", "loaded,", "initialized,", "paused", "or", "running" });
+    }
+    writer_stream << "setParticipantState FEP_SYSTEM test_part_0 runnimg" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "state", "\"runnimg\",", "use",
+        "shutdowned,", "unloaded,", "loaded,", "initialized,", "paused", "or", "running" });
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "4", "-", "initialized", "-", "homogeneous", ":", "1" });
+
+    closeSession(c, writer_stream);
+}
+
 /**
 * @brief Test getCurrentTimingMaster, configureTiming3SystemTime, configureTiming3NoSync and configureTiming3DiscreteTime
 */
@@ -720,3 +966,1052 @@ TEST(ControlTool, testAutoDiscovery)
     checkUntilPrompt(c, reader_stream, expected_answer_state_initialized);
 
 }
+
+/**
+* @brief Test transitionStats records system and participant transitions
+*/
+TEST(ControlTool, testTransitionStats)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "transitionStats" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "transitions", "recorded" });
+
+    writer_stream << "startSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", "started" });
+
+    writer_stream << "stopParticipant FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_0@FEP_SYSTEM", "stopped" });
+
+    writer_stream << "transitionStats" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    const std::vector<std::string> header = { "system", "participant", "transition", "count", "failed",
+        "p50[ms]", "p95[ms]", "p99[ms]", "max[ms]" };
+    ASSERT_EQ(answer.size(), 3u * header.size());
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 9), header);
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 9, answer.begin() + 14),
+        std::vector<std::string>({ "FEP_SYSTEM", "*", "start", "1", "0" }));
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 18, answer.begin() + 23),
+        std::vector<std::string>({ "FEP_SYSTEM", "test_part_0", "stop", "1", "0" }));
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test cycleSystem runs the given transitions and writes a report
+*/
+TEST(ControlTool, testCycleSystem)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "cycleSystem FEP_SYSTEM 3 jump" << std::endl;
+    const auto answer_invalid = readUntilPrompt(c, reader_stream);
+    ASSERT_FALSE(answer_invalid.empty());
+    EXPECT_EQ(answer_invalid[0], "invalid");
+
+    writer_stream << "cycleSystem FEP_SYSTEM 99999999999999999999999" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "number", "of", "cycles", "\"99999999999999999999999\"" });
+
+    const auto report_file = a_util::filesystem::getWorkingDirectory() + "cycle_report.json";
+    writer_stream << "cycleSystem FEP_SYSTEM 3 start,stop " << quoteFilenameIfNecessary(report_file.toString()) << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 3u);
+    EXPECT_EQ(answer[0], "FEP_SYSTEM");
+    EXPECT_EQ(answer[1], "3");
+    EXPECT_EQ(answer[2], "cycles");
+    EXPECT_TRUE(a_util::filesystem::exists(report_file));
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    const std::vector<std::string> expected_answer_state_initialized = { "4", "-", "initialized", "-", "homogeneous", ":", "1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_state_initialized);
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::remove(report_file);
+}
+
+/**
+* @brief Test system commands with glob patterns and lists of system names
+*/
+TEST(ControlTool, testSystemPatterns)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "startSystem NO_SYSTEM_*" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "system", "matches", "\"NO_SYSTEM_*\"" });
+
+    writer_stream << "startSystem FEP_*" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", "started", "1", "of", "1", "systems", "started" });
+
+    writer_stream << "getSystemState FEP_S?STEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", "-", "6", "-", "running", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "stopSystem FEP_SYSTEM,NO_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "system", "\"NO_SYSTEM\"", "is", "not", "connected",
+        "FEP_SYSTEM", "stopped", "1", "of", "2", "systems", "stopped" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test background jobs with &, jobs, wait and cancel
+*/
+TEST(ControlTool, testBackgroundJobs)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "jobs" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "jobs" });
+
+    writer_stream << "quit &" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "\"quit\"", "cannot", "run", "in", "background" });
+
+    writer_stream << "startSystem FEP_SYSTEM &" << std::endl;
+    writer_stream << "wait 1" << std::endl;
+    writer_stream << "cancel 1" << std::endl;
+    const auto answer = readUntilPromptAfter(c, reader_stream, { "[1]", "is", "already", "done" });
+    // submit message, completion message, the one of wait and the one of cancel
+    EXPECT_EQ(std::count(answer.begin(), answer.end(), "[1]"), 4);
+    EXPECT_NE(std::find(answer.begin(), answer.end(), "started"), answer.end());
+    EXPECT_EQ(std::count(answer.begin(), answer.end(), "finished"), 2);
+
+    writer_stream << "cancel 2" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "such", "job", "2" });
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    const std::vector<std::string> expected_answer_state_running = { "6", "-", "running", "-", "homogeneous", ":", "1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_state_running);
+
+    // the job finishes while the prompt is shown, linenoise may have the terminal in raw mode then
+    writer_stream << "stopSystem FEP_SYSTEM &" << std::endl;
+    std::string line;
+    while (c.running() && std::getline(reader_stream, line) && line.find("finished") == std::string::npos)
+    {
+    }
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\r');
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "4", "-", "initialized", "-", "homogeneous", ":", "1" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test system transitions with canary stage
+*/
+TEST(ControlTool, testCanaryTransitions)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "enableCanaryTransitions 0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "canary", "count", "or", "concurrency" });
+
+    writer_stream << "enableCanaryTransitions 1 2" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "canary", "transitions:", "enabled", "(1", "canaries,", "2", "workers)" });
+
+    writer_stream << "startSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", "started" });
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    const std::vector<std::string> expected_answer_state_running = { "6", "-", "running", "-", "homogeneous", ":", "1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_state_running);
+
+    writer_stream << "pauseParticipant FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_0@FEP_SYSTEM", "paused" });
+
+    // the participants are in states the load transition does not start from, it is refused before the canaries
+    writer_stream << "loadSystem FEP_SYSTEM" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 8u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 8),
+        std::vector<std::string>({ "cannot", "load", "system", "\"FEP_SYSTEM\",", "error:", "participants", "cannot", "load" }));
+    EXPECT_NE(std::find(answer.begin(), answer.end(), "paused;"), answer.end());
+    EXPECT_EQ(answer.back(), "touched");
+
+    writer_stream << "getParticipantState FEP_SYSTEM test_part_1" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "6", "-", "running" });
+
+    writer_stream << "disableCanaryTransitions" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "canary", "transitions:", "disabled" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test the rollback of canaries and finishing a partially done staged transition
+*/
+TEST(ControlTool, testCanaryRollback)
+{
+    using namespace fep3::core;
+    auto test_parts = createTestParticipants({ "test_part_0", "test_part_1" }, "FEP_SYSTEM");
+    // sorts before the test_part_* participants, so it is the first canary
+    std::unique_ptr<PartStruct> failing_part(new PartStruct(
+        createParticipant<ElementFactory<FailingElement>>("failing_part", "1.0", "FEP_SYSTEM")));
+    failing_part->_part_executor.exec();
+    test_parts["failing_part"] = std::move(failing_part);
+    fep3::System fep_system("FEP_SYSTEM");
+    for (const auto& test_part : test_parts)
+    {
+        fep_system.add(test_part.first);
+    }
+    fep_system.load();
+    initialize_failures = 2;
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    auto expect_state = [&](const std::string& participant_name, const std::vector<std::string>& state)
+    {
+        writer_stream << "getParticipantState FEP_SYSTEM " << participant_name << std::endl;
+        checkUntilPrompt(c, reader_stream, state);
+    };
+    const std::vector<std::string> loaded = { "3", "-", "loaded" };
+    // the reason is the error of the participant or its state after the transition
+    const std::vector<std::string> canary_failed = { "canary", "stage", "failed" };
+    auto failed_part = [](const std::string& token) { return token.compare(0u, 13u, "(failing_part") == 0; };
+
+    // the only canary fails, nothing else is touched
+    writer_stream << "enableCanaryTransitions 1" << std::endl;
+    readUntilPrompt(c, reader_stream);
+    writer_stream << "initializeSystem FEP_SYSTEM" << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    EXPECT_NE(std::search(answer.begin(), answer.end(), canary_failed.begin(), canary_failed.end()), answer.end());
+    EXPECT_NE(std::find_if(answer.begin(), answer.end(), failed_part), answer.end());
+    const std::vector<std::string> two_untouched = { "2", "participants", "were", "not", "touched" };
+    EXPECT_NE(std::search(answer.begin(), answer.end(), two_untouched.begin(), two_untouched.end()), answer.end());
+    expect_state("test_part_0", loaded);
+    expect_state("test_part_1", loaded);
+
+    // test_part_0 succeeds as a canary and is rolled back, test_part_1 is not touched
+    writer_stream << "enableCanaryTransitions 2" << std::endl;
+    readUntilPrompt(c, reader_stream);
+    writer_stream << "initializeSystem FEP_SYSTEM" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    EXPECT_NE(std::search(answer.begin(), answer.end(), canary_failed.begin(), canary_failed.end()), answer.end());
+    EXPECT_NE(std::find_if(answer.begin(), answer.end(), failed_part), answer.end());
+    const std::vector<std::string> one_untouched = { "1", "participants", "were", "not", "touched" };
+    EXPECT_NE(std::search(answer.begin(), answer.end(), one_untouched.begin(), one_untouched.end()), answer.end());
+    EXPECT_EQ(std::find(answer.begin(), answer.end(), "rollback"), answer.end());
+    expect_state("test_part_0", loaded);
+    expect_state("test_part_1", loaded);
+
+    // participants already initialized are skipped, so the transition can be finished
+    writer_stream << "initializeParticipant FEP_SYSTEM test_part_1" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_1@FEP_SYSTEM", "initialized" });
+    writer_stream << "initializeSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "FEP_SYSTEM", "initialized" });
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "4", "-", "initialized", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "disableCanaryTransitions" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "canary", "transitions:", "disabled" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test repeated participant queries reusing the cached RPC proxies
+*/
+TEST(ControlTool, testRepeatedParticipantQueries)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    for (int query = 0; query < 20; ++query)
+    {
+        writer_stream << "getParticipantState FEP_SYSTEM test_part_0" << std::endl;
+        checkUntilPrompt(c, reader_stream, { "4", "-", "initialized" });
+    }
+
+    writer_stream << "startParticipant FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_0@FEP_SYSTEM", "started" });
+
+    writer_stream << "getParticipantState FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "6", "-", "running" });
+
+    writer_stream << "getParticipantState FEP_SYSTEM test_part_2" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "participant", "\"test_part_2\"", "is", "not", "in", "system", "\"FEP_SYSTEM\"" });
+
+    // the discovery replaces the system and its cached proxies
+    writer_stream << "discoverSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "getParticipantState FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "6", "-", "running" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test the background discovery with enableBackgroundDiscovery, waitForParticipantChanges and disableBackgroundDiscovery
+*/
+TEST(ControlTool, testBackgroundDiscovery)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "waitForParticipantChanges" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "background", "discovery", "is", "not", "enabled" });
+
+    writer_stream << "enableBackgroundDiscovery 200" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "background", "discovery:", "enabled", "(every", "200", "ms)" });
+
+    // the console event is printed before the waiters are woken up, no events follow the disabling
+    // the second wait only reports changes newer than the ones printed by the first
+    writer_stream << "waitForParticipantChanges 20000" << std::endl;
+    writer_stream << "waitForParticipantChanges 1000" << std::endl;
+    writer_stream << "disableBackgroundDiscovery" << std::endl;
+    const auto answer = readUntilPromptAfter(c, reader_stream, { "background", "discovery:", "disabled" });
+    EXPECT_GE(std::count(answer.begin(), answer.end(), "changed!"), 2);
+    EXPECT_GE(std::count(answer.begin(), answer.end(), "FEP_SYSTEM"), 2);
+    EXPECT_GE(std::count(answer.begin(), answer.end(), "joined:"), 2);
+    const std::vector<std::string> expected_no_changes = { "no", "participant", "changes", "within", "1000", "ms" };
+    EXPECT_NE(std::search(answer.begin(), answer.end(), expected_no_changes.begin(), expected_no_changes.end()), answer.end());
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    const std::vector<std::string> expected_answer_state = { "4", "-", "initialized", "-", "homogeneous", ":", "1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_state);
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test snapshot writes all participants of a system to a file
+*/
+TEST(ControlTool, testSnapshot)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    const auto snapshot_file = a_util::filesystem::getWorkingDirectory() + "snapshot.fep";
+    writer_stream << "snapshot FEP_SYSTEM " << quoteFilenameIfNecessary(snapshot_file.toString()) << " 0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "concurrency", "\"0\"" });
+
+    writer_stream << "snapshot FEP_SYSTEM " << quoteFilenameIfNecessary(snapshot_file.toString()) << " 2" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 6u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 6),
+        std::vector<std::string>({ "snapshot", "of", "\"FEP_SYSTEM\"", "with", "2", "participants" }));
+
+    std::string content;
+    ASSERT_EQ(a_util::filesystem::readTextFile(snapshot_file, content), a_util::filesystem::OK);
+    EXPECT_EQ(content.find("fep_snapshot 1\nsystem FEP_SYSTEM\nsystem_state 4 1\n"), 0u);
+    const auto part_0 = content.find("participant test_part_0\nstate 4\n");
+    const auto part_1 = content.find("participant test_part_1\nstate 4\n");
+    ASSERT_NE(part_0, std::string::npos);
+    ASSERT_NE(part_1, std::string::npos);
+    EXPECT_LT(part_0, part_1);
+    EXPECT_NE(content.find("rpc_object participant_statemachine\n"), std::string::npos);
+    EXPECT_NE(content.find("\ndefinition "), std::string::npos);
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::remove(snapshot_file);
+}
+
+/**
+* @brief Test diffSnapshot reports the changed sections of two snapshots
+*/
+TEST(ControlTool, testDiffSnapshot)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    const auto before_file = a_util::filesystem::getWorkingDirectory() + "snapshot_before.fep";
+    const auto after_file = a_util::filesystem::getWorkingDirectory() + "snapshot_after.fep";
+    writer_stream << "snapshot FEP_SYSTEM " << quoteFilenameIfNecessary(before_file.toString()) << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    writer_stream << "startParticipant FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_0@FEP_SYSTEM", "started" });
+
+    writer_stream << "snapshot FEP_SYSTEM " << quoteFilenameIfNecessary(after_file.toString()) << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    writer_stream << "diffSnapshot " << quoteFilenameIfNecessary(before_file.toString()) << " "
+        << quoteFilenameIfNecessary(before_file.toString()) << std::endl;
+    checkUntilPrompt(c, reader_stream, { "3", "sections", "unchanged,", "0", "changed" });
+
+    writer_stream << "diffSnapshot " << quoteFilenameIfNecessary(before_file.toString()) << " "
+        << quoteFilenameIfNecessary(after_file.toString()) << std::endl;
+    checkUntilPrompt(c, reader_stream, { "system:", "system_state", "4", "1", "->", "4", "0",
+        "participant", "test_part_0:", "state", "4", "->", "6",
+        "1", "sections", "unchanged,", "2", "changed" });
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::remove(before_file);
+    a_util::filesystem::remove(after_file);
+}
+
+/**
+* @brief Test the interface definition cache with definitionCache and getParticipantRPCObjectIIDDefinition
+*/
+TEST(ControlTool, testDefinitionCache)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "definitionCache off" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "definition", "cache:", "off,", "0", "hits,", "0", "misses" });
+
+    const auto cache_directory = a_util::filesystem::getWorkingDirectory() + "definition_cache_test";
+    writer_stream << "definitionCache " << quoteFilenameIfNecessary(cache_directory.toString()) << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    writer_stream << "getParticipantRPCObjectIIDs FEP_SYSTEM test_part_0 participant_statemachine" << std::endl;
+    const auto iids = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(iids.size(), 1u);
+    const auto iid = a_util::strings::split(iids[0], ",").front();
+
+    for (int query = 0; query < 2; ++query)
+    {
+        writer_stream << "getParticipantRPCObjectIIDDefinition FEP_SYSTEM test_part_1 participant_statemachine " << iid << std::endl;
+        EXPECT_FALSE(readUntilPrompt(c, reader_stream).empty());
+    }
+
+    writer_stream << "definitionCache" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 4u);
+    EXPECT_EQ(std::vector<std::string>(answer.end() - 4, answer.end()),
+        std::vector<std::string>({ "1", "hits,", "1", "misses" }));
+    EXPECT_TRUE(a_util::filesystem::exists(cache_directory + "objects"));
+
+    closeSession(c, writer_stream);
+    //a_util removes empty directories only
+    boost::filesystem::remove_all(cache_directory.toString());
+}
+
+/**
+* @brief Test rpcCall on the state machine of a participant
+*/
+TEST(ControlTool, testRPCCall)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "getParticipantRPCObjectIIDs FEP_SYSTEM test_part_0 participant_statemachine" << std::endl;
+    const auto iids = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(iids.size(), 1u);
+    const auto iid = a_util::strings::split(iids[0], ",").front();
+    const std::string call = "rpcCall FEP_SYSTEM test_part_0 participant_statemachine " + iid + " ";
+
+    auto check_call = [&](const std::string& method, const std::string& expected_response)
+    {
+        writer_stream << call << method << std::endl;
+        const auto answer = readUntilPrompt(c, reader_stream);
+        ASSERT_EQ(answer.size(), 6u);
+        EXPECT_EQ(answer[0], expected_response);
+        EXPECT_EQ(std::vector<std::string>(answer.begin() + 1, answer.begin() + 4),
+            std::vector<std::string>({ "round", "trip", "time:" }));
+        EXPECT_EQ(answer[5], "ms");
+    };
+    check_call("getState", "4");
+    check_call("start", "null");
+    check_call("getState", "6");
+
+    writer_stream << call << "getState [\"x\"]" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "\"getState\"", "takes", "0", "parameters", "(1", "given)" });
+
+    writer_stream << call << "getState [1]" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "parameters,", "expected", "a", "string", "value", "at", "position", "1" });
+
+    writer_stream << call << "jump" << std::endl;
+    const auto answer_unknown = readUntilPrompt(c, reader_stream);
+    //"for" is one of the skippables dropped by readUntilPrompt
+    ASSERT_GE(answer_unknown.size(), 4u);
+    EXPECT_EQ(std::vector<std::string>(answer_unknown.begin(), answer_unknown.begin() + 4),
+        std::vector<std::string>({ "no", "client", "method", "\"jump\"" }));
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test the RPC latency benchmark on all and on a single participant
+*/
+TEST(ControlTool, testRPCBench)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    const std::vector<std::string> header = { "participant", "count", "failed", "p50[ms]", "p95[ms]", "p99[ms]", "max[ms]", "calls/s" };
+    writer_stream << "rpcBench FEP_SYSTEM 5 2" << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 3u * header.size() + 10u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + header.size()), header);
+    EXPECT_EQ(answer[8], "test_part_0");
+    EXPECT_EQ(answer[9], "5");
+    EXPECT_EQ(answer[10], "0");
+    EXPECT_EQ(answer[16], "test_part_1");
+    EXPECT_EQ(answer[17], "5");
+    EXPECT_EQ(answer[18], "0");
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 24, answer.begin() + 29),
+        std::vector<std::string>({ "total", "10", "calls,", "0", "failed" }));
+
+    writer_stream << "rpcBench FEP_SYSTEM test_part_1 3 1" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 2u * header.size() + 10u);
+    EXPECT_EQ(answer[8], "test_part_1");
+    EXPECT_EQ(answer[9], "3");
+    EXPECT_EQ(answer[16], "total");
+    EXPECT_EQ(answer[17], "3");
+
+    writer_stream << "rpcBench FEP_SYSTEM not_existing 3 1" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "participant", "\"not_existing\"", "is", "not", "in", "system", "\"FEP_SYSTEM\"" });
+
+    writer_stream << "rpcBench FEP_SYSTEM x 1" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "number", "of", "calls", "\"x\"" });
+
+    writer_stream << "rpcBench FEP_SYSTEM 3 0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "concurrency", "\"0\"" });
+
+    writer_stream << "help rpcBench" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    const std::vector<std::string> usage = { "rpcBench", "<system", "name>", "<optional", "participant", "name>",
+        "<number", "of", "calls>", "<concurrency>", ":" };
+    ASSERT_GE(answer.size(), usage.size());
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + usage.size()), usage);
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test that configureSystem reuses the compiled properties file
+*/
+TEST(ControlTool, testPropertyCache)
+{
+    const auto current_path = a_util::filesystem::getWorkingDirectory();
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "propertyCache off" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "property", "cache:", "off,", "0", "hits,", "0", "misses" });
+
+    const auto cache_directory = current_path + "property_cache_test";
+    writer_stream << "propertyCache " << quoteFilenameIfNecessary(cache_directory.toString()) << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    const auto test_files_path = current_path + "files";
+    writer_stream << "setCurrentWorkingDirectory " << quoteFilenameIfNecessary(test_files_path.toString()) << std::endl;
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "connectSystem \"DEMO fep_sdk.system\"" << std::endl;
+    const std::vector<std::string> expected_answer_participants = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer_participants);
+
+    for (int configuration = 0; configuration < 2; ++configuration)
+    {
+        writer_stream << "configureSystem FEP_SYSTEM DEMO_clock.properties delta" << std::endl;
+        const auto answer = readUntilPrompt(c, reader_stream);
+        ASSERT_FALSE(answer.empty());
+        EXPECT_EQ(answer.back(), "participants");
+    }
+
+    // two saves of the same size within one tick of the modification time are told apart by the content
+    const auto same_size_file = test_files_path + "property_cache_same_size.properties";
+    const std::time_t modification_time = std::time(nullptr) - 60;
+    for (const auto revision : { "A", "B" })
+    {
+        std::ofstream(same_size_file.toString()) << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+            << "<property_file xmlns=\"http://fep.vwgroup.com/system/2.0/properties\">\n"
+            << "    <schema_version>2.0.0</schema_version>\n"
+            << "    <!-- revision " << revision << " -->\n"
+            << "    <system_properties/>\n"
+            << "</property_file>\n";
+        boost::filesystem::last_write_time(same_size_file.toString(), modification_time);
+        writer_stream << "configureSystem FEP_SYSTEM property_cache_same_size.properties delta" << std::endl;
+        readUntilPrompt(c, reader_stream);
+    }
+    a_util::filesystem::remove(same_size_file);
+
+    writer_stream << "propertyCache" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 4u);
+    EXPECT_EQ(std::vector<std::string>(answer.end() - 4, answer.end()),
+        std::vector<std::string>({ "1", "hits,", "3", "misses" }));
+    EXPECT_TRUE(a_util::filesystem::exists(cache_directory));
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::setWorkingDirectory(current_path);
+    //a_util removes empty directories only
+    boost::filesystem::remove_all(cache_directory.toString());
+}
+
+/**
+* @brief Test that edits of a watched properties file are pushed to the system
+*/
+TEST(ControlTool, testWatchConfiguration)
+{
+    const auto current_path = a_util::filesystem::getWorkingDirectory();
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    const auto properties_file = current_path + "watched.properties";
+    auto writeProperties = [&](const std::string& main_clock)
+    {
+        std::string content;
+        ASSERT_EQ(a_util::filesystem::readTextFile(current_path + "files/DEMO_clock.properties", content), a_util::filesystem::OK);
+        const std::string default_clock = "local_system_realtime";
+        content.replace(content.find(default_clock), default_clock.size(), main_clock);
+        ASSERT_EQ(a_util::filesystem::writeTextFile(properties_file, content), a_util::filesystem::OK);
+    };
+    writeProperties("local_system_realtime");
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "watchConfiguration FEP_SYSTEM " << quoteFilenameIfNecessary(properties_file.toString()) << " 50" << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    EXPECT_NE(std::find(answer.begin(), answer.end(), "watching"), answer.end());
+
+    writeProperties("local_system_simtime");
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+
+    //the update is printed by the watcher thread and redraws the prompt, the watcher is stopped by the first command
+    writer_stream << "stopWatchingConfiguration FEP_SYSTEM" << std::endl;
+    writer_stream << "stopWatchingConfiguration FEP_SYSTEM" << std::endl;
+    answer = readUntilPromptAfter(c, reader_stream, { "no", "configuration", "is", "watched" });
+    const std::vector<std::string> expected_update = { "configuration", "of", "\"FEP_SYSTEM\"", "updated" };
+    EXPECT_NE(std::search(answer.begin(), answer.end(), expected_update.begin(), expected_update.end()), answer.end());
+    const auto changed = std::find(answer.begin(), answer.end(), "changed");
+    ASSERT_TRUE(changed - answer.begin() >= 2 && answer.end() - changed >= 4);
+    EXPECT_EQ(std::vector<std::string>(changed - 2, changed + 4),
+        std::vector<std::string>({ "1", "properties", "changed", "on", "1", "participants" }));
+
+    //discovering the system again replaces its entry and stops the watcher of the old one
+    writer_stream << "watchConfiguration FEP_SYSTEM " << quoteFilenameIfNecessary(properties_file.toString()) << " 50" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    EXPECT_NE(std::find(answer.begin(), answer.end(), "watching"), answer.end());
+    writer_stream << "discoverSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, expected_answer);
+    writer_stream << "stopWatchingConfiguration FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "configuration", "is", "watched", "for", "system", "\"FEP_SYSTEM\"" });
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::remove(properties_file);
+}
+
+/**
+* @brief Test reading and setting properties of several participants
+*/
+TEST(ControlTool, testGetSetProperties)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "getProperties FEP_SYSTEM test_part_0 clock/main_clock" << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 4u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 3),
+        std::vector<std::string>({ "test_part_0", "clock/main_clock", "string" }));
+
+    //participants answer in any order
+    writer_stream << "setProperties FEP_SYSTEM * clock/main_clock=local_system_simtime" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 12u);
+    std::sort(answer.begin(), answer.end());
+    EXPECT_EQ(answer, std::vector<std::string>({ "1", "1", "1", "1", "of", "of", "properties", "properties",
+        "set", "set", "test_part_0", "test_part_1" }));
+
+    writer_stream << "getProperties FEP_SYSTEM test_part_? clock/main_*" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 8u);
+    std::sort(answer.begin(), answer.end());
+    EXPECT_EQ(answer, std::vector<std::string>({ "clock/main_clock", "clock/main_clock", "local_system_simtime",
+        "local_system_simtime", "string", "string", "test_part_0", "test_part_1" }));
+
+    writer_stream << "setProperties FEP_SYSTEM test_part_1 clock/not_existing=1" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "test_part_1", "0", "of", "1", "properties", "set",
+        "participant", "\"test_part_1@FEP_SYSTEM\"", "refused", "the", "properties", "clock/not_existing" });
+
+    writer_stream << "setProperties FEP_SYSTEM test_part_1 clock/main_clock" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "assignment", "\"clock/main_clock\",", "use", "<property", "path>=<value>" });
+
+    writer_stream << "getProperties FEP_SYSTEM other_* clock/main_clock" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "no", "participant", "of", "system", "\"FEP_SYSTEM\"", "matches", "\"other_*\"" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test that restoreConfiguration only sets the properties changed since saveConfiguration
+*/
+TEST(ControlTool, testSaveRestoreConfiguration)
+{
+    const auto current_path = a_util::filesystem::getWorkingDirectory();
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    const auto configuration_file = current_path + "configuration_test.bin";
+    writer_stream << "saveConfiguration FEP_SYSTEM " << quoteFilenameIfNecessary(configuration_file.toString()) << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 5u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 1, answer.begin() + 5),
+        std::vector<std::string>({ "properties", "of", "2", "participants" }));
+    const auto saved_properties = answer[0];
+
+    writer_stream << "setProperties FEP_SYSTEM test_part_0 clock/main_clock=local_system_simtime" << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    auto checkRestore = [&](const std::string& changed_properties, const std::string& changed_participants)
+    {
+        writer_stream << "restoreConfiguration FEP_SYSTEM " << quoteFilenameIfNecessary(configuration_file.toString()) << std::endl;
+        const auto answer = readUntilPrompt(c, reader_stream);
+        ASSERT_EQ(answer.size(), 12u);
+        EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 10),
+            std::vector<std::string>({ changed_properties, "of", saved_properties, "properties", "changed", "on",
+                changed_participants, "participants", "restored", "in" }));
+    };
+    checkRestore("1", "1");
+    checkRestore("0", "0");
+
+    writer_stream << "getProperties FEP_SYSTEM test_part_0 clock/main_clock" << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 4u);
+    EXPECT_NE(answer[3], "local_system_simtime");
+
+    writer_stream << "restoreConfiguration FEP_SYSTEM " << quoteFilenameIfNecessary((current_path + "files/DEMO.properties").toString()) << std::endl;
+    answer = readUntilPrompt(c, reader_stream);
+    ASSERT_GE(answer.size(), 6u);
+    EXPECT_EQ(std::vector<std::string>(answer.end() - 6, answer.end()),
+        std::vector<std::string>({ "is", "no", "configuration", "written", "by", "saveConfiguration" }));
+
+    closeSession(c, writer_stream);
+    a_util::filesystem::remove(configuration_file);
+}
+
+/**
+* @brief Test timingMonitor on a running system without timing master
+*/
+TEST(ControlTool, testTimingMonitor)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "timingMonitor FEP_SYSTEM 3 200" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 10u + 3u * 5u + 3u * 7u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 10),
+        std::vector<std::string>({ "no", "timing", "master", "in", "system", "\"FEP_SYSTEM\",", "only", "ratios", "are", "measured" }));
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 10, answer.begin() + 15),
+        std::vector<std::string>({ "round", "1:", "no", "timing", "master" }));
+    EXPECT_EQ(std::vector<std::string>(answer.begin() + 25, answer.begin() + 32),
+        std::vector<std::string>({ "participant", "samples", "failed", "ratio", "jitter", "mean_skew[ms]", "max_abs_skew[ms]" }));
+    for (size_t line = 0u; line < 2u; ++line)
+    {
+        const auto participant = answer.begin() + 32 + line * 7u;
+        EXPECT_EQ(participant[0], "test_part_" + std::to_string(line));
+        EXPECT_EQ(participant[1], "3");
+        EXPECT_EQ(participant[2], "0");
+        // the participants run in real time on the local system time
+        EXPECT_NEAR(std::stod(participant[3]), 1.0, 0.2);
+        EXPECT_EQ(participant[5], "-");
+    }
+
+    writer_stream << "timingMonitor FEP_SYSTEM 0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "number", "of", "samples", "\"0\"" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test timingMonitor measuring the skew to a System Time timing master
+*/
+TEST(ControlTool, testTimingMonitorWithMaster)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    // the timing configuration is read when the participants are initialized
+    writer_stream << "setSystemState FEP_SYSTEM loaded" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "3", "-", "loaded", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "configureTiming3SystemTime FEP_SYSTEM test_part_0" << std::endl;
+    checkUntilPrompt(c, reader_stream, {});
+
+    writer_stream << "setSystemState FEP_SYSTEM running" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "6", "-", "running", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "timingMonitor FEP_SYSTEM 3 200" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    const std::vector<std::string> round = { "round", "1:", "master" };
+    EXPECT_NE(std::search(answer.begin(), answer.end(), round.begin(), round.end()), answer.end());
+    const std::vector<std::string> header = { "participant", "samples", "failed", "ratio", "jitter", "mean_skew[ms]", "max_abs_skew[ms]" };
+    const auto summary = std::search(answer.begin(), answer.end(), header.begin(), header.end());
+    ASSERT_EQ(answer.end() - summary, 3 * 7);
+
+    const auto master = summary + 7;
+    EXPECT_EQ(master[0], "test_part_0(master)");
+    EXPECT_EQ(master[1], "3");
+    EXPECT_EQ(master[5], "-");
+
+    const auto slave = summary + 14;
+    EXPECT_EQ(slave[0], "test_part_1");
+    EXPECT_EQ(slave[1], "3");
+    EXPECT_EQ(slave[2], "0");
+    // the slave follows the clock of the master, only the RPC round trips add to the skew
+    ASSERT_NE(slave[5], "-");
+    EXPECT_LT(std::abs(std::stod(slave[5])), 1000.0);
+    EXPECT_LT(std::abs(std::stod(slave[6])), 1000.0);
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test timingSweep with two factors of Discrete Time
+*/
+TEST(ControlTool, testTimingSweep)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "timingSweep FEP_SYSTEM test_part_0 100000000 1.0,2.0 1000" << std::endl;
+    const auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 3u * 6u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 6),
+        std::vector<std::string>({ "step_size[ns]", "factor", "sim_time[s]", "wall_time[s]", "throughput", "drift[ms]" }));
+    EXPECT_EQ(answer[6], "100000000");
+    EXPECT_EQ(answer[7], "1.0");
+    EXPECT_NEAR(std::stod(answer[10]), 1.0, 0.3);
+    EXPECT_EQ(answer[13], "2.0");
+    EXPECT_NEAR(std::stod(answer[16]), 2.0, 0.6);
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "3", "-", "loaded", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "timingSweep FEP_SYSTEM not_existing 100000000 1.0 1000" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "participant", "\"not_existing\"", "is", "not", "in", "system", "\"FEP_SYSTEM\"" });
+
+    writer_stream << "timingSweep FEP_SYSTEM test_part_0 100000000 1.0 0" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "invalid", "duration", "\"0\"" });
+
+    closeSession(c, writer_stream);
+}
+
+/**
+* @brief Test timingPreflight, enableTimingPreflight and disableTimingPreflight with a timing master not in the system
+*/
+TEST(ControlTool, testTimingPreflight)
+{
+    TestParticipants test_parts;
+    auto fep_system = createSystem(test_parts, false);
+
+    bp::opstream writer_stream;
+    bp::ipstream reader_stream;
+    bp::child c(binary_tool_path, bp::std_out > reader_stream, bp::std_in < writer_stream);
+    skipUntilPrompt(c, reader_stream);
+
+    writer_stream << "discoverAllSystems" << std::endl;
+    const std::vector<std::string> expected_answer = { "FEP_SYSTEM", ":", "test_part_0,", "test_part_1" };
+    checkUntilPrompt(c, reader_stream, expected_answer);
+
+    writer_stream << "timingPreflight FEP_SYSTEM" << std::endl;
+    auto answer = readUntilPrompt(c, reader_stream);
+    ASSERT_EQ(answer.size(), 8u);
+    EXPECT_EQ(std::vector<std::string>(answer.begin(), answer.begin() + 6),
+        std::vector<std::string>({ "timing", "preflight", "of", "\"FEP_SYSTEM\"", "passed", "in" }));
+
+    writer_stream << "setProperties FEP_SYSTEM test_part_1 clock_synchronization/timing_master=not_existing" << std::endl;
+    readUntilPrompt(c, reader_stream);
+
+    const std::vector<std::string> master_missing = { "timing", "preflight", "of", "\"FEP_SYSTEM\":",
+        "timing", "master", "\"not_existing\"", "is", "not", "in", "the", "system" };
+    writer_stream << "timingPreflight FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, master_missing);
+
+    writer_stream << "enableTimingPreflight" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "timing", "preflight:", "enabled" });
+
+    std::vector<std::string> start_refused = master_missing;
+    start_refused.insert(start_refused.end(), { "cannot", "start", "system", "\"FEP_SYSTEM\",", "the", "timing", "preflight", "failed" });
+    writer_stream << "startSystem FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, start_refused);
+
+    std::vector<std::string> participant_refused = master_missing;
+    participant_refused.insert(participant_refused.end(), { "cannot", "set", "participant", "state", "\"running\"",
+        "participant", "\"test_part_0@FEP_SYSTEM\",", "the", "timing", "preflight", "failed" });
+    writer_stream << "setParticipantState FEP_SYSTEM test_part_0 running" << std::endl;
+    checkUntilPrompt(c, reader_stream, participant_refused);
+
+    std::vector<std::string> cycle_refused = master_missing;
+    cycle_refused.insert(cycle_refused.end(), { "cannot", "cycle", "system", "\"FEP_SYSTEM\",", "the", "timing", "preflight", "failed" });
+    writer_stream << "cycleSystem FEP_SYSTEM 1 start" << std::endl;
+    checkUntilPrompt(c, reader_stream, cycle_refused);
+
+    writer_stream << "getSystemState FEP_SYSTEM" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "4", "-", "initialized", "-", "homogeneous", ":", "1" });
+
+    writer_stream << "disableTimingPreflight" << std::endl;
+    checkUntilPrompt(c, reader_stream, { "timing", "preflight:", "disabled" });
+
+    closeSession(c, writer_stream);
+}